@@ -9,6 +9,7 @@
 #include "Config.hpp"
 #include <iostream>
 #include "ServerUpdateManager.hpp"
+#include "ReplayReader.hpp"
 #include "BoardRenderer.hpp"
 #include "TextRenderer.hpp"
 #include "Theme.hpp"
@@ -19,6 +20,7 @@
 #include <unordered_map>
 #include <memory>
 #include <cctype>
+#include <cstdio>
 #include <regex>
 
 #define THEME_COUNT 6
@@ -39,6 +41,13 @@ bool isValidIPv4(const std::string& ip) {
     return true;
 }
 
+bool isValidHost(const std::string& host) {
+    if (host.rfind("unix:", 0) == 0 || host.rfind("shm:", 0) == 0 ||
+        host.rfind("replay:", 0) == 0)
+        return host.find(':') + 1 < host.size();
+    return isValidIPv4(host);
+}
+
 bool isValidIPv4Char(char c) {
     return std::isdigit(c) || c == '.';
 }
@@ -206,6 +215,9 @@ void App::handleEvents(bool& running) {
         if (e.type == SDL_QUIT)
             running = false;
         else if (e.type == SDL_KEYDOWN) {
+            if (state == GameState::GAME && !showingHelp && !isPaused &&
+                handleReplayKey(e.key.keysym.sym))
+                continue;
             switch (e.key.keysym.sym) {
                 case SDLK_ESCAPE:
                     if (showingHelp) {
@@ -514,6 +526,73 @@ void App::handleEvents(bool& running) {
     }
 }
 
+bool App::handleReplayKey(SDL_Keycode key) {
+    ReplayReader *replay = server.getReplay();
+
+    if (!replay)
+        return false;
+    uint64_t pos = replay->getPosition();
+    switch (key) {
+        case SDLK_SPACE:
+            replay->togglePause();
+            break;
+        case SDLK_UP:
+            replay->setSpeed(replay->getSpeed() * 2);
+            break;
+        case SDLK_DOWN:
+            replay->setSpeed(replay->getSpeed() / 2);
+            break;
+        case SDLK_LEFT:
+            replay->seek(pos - std::min(pos, Config::REPLAY_SHORT_SEEK_MS));
+            break;
+        case SDLK_RIGHT:
+            replay->seek(pos + Config::REPLAY_SHORT_SEEK_MS);
+            break;
+        case SDLK_PAGEDOWN:
+            replay->seek(pos - std::min(pos, Config::REPLAY_LONG_SEEK_MS));
+            break;
+        case SDLK_PAGEUP:
+            replay->seek(pos + Config::REPLAY_LONG_SEEK_MS);
+            break;
+        case SDLK_HOME:
+            replay->seek(0);
+            break;
+        case SDLK_END:
+            replay->seek(replay->getDuration());
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+static std::string formatClock(uint64_t ms) {
+    char buf[32];
+    uint64_t s = ms / 1000;
+
+    snprintf(buf, sizeof(buf), "%llu:%02llu:%02llu",
+        static_cast<unsigned long long>(s / 3600),
+        static_cast<unsigned long long>(s / 60 % 60),
+        static_cast<unsigned long long>(s % 60));
+    return buf;
+}
+
+void App::updateReplayTitle() {
+    const ReplayReader *replay = server.getReplay();
+
+    if (!replay)
+        return;
+    std::string title = std::string(Config::WINDOW_TITLE) + " - replay " +
+        formatClock(replay->getPosition()) + " / " +
+        formatClock(replay->getDuration()) + " x" +
+        std::to_string(replay->getSpeed()) +
+        (replay->isPaused() ? " (paused)" : "");
+    if (title != replayTitle) {
+        replayTitle = title;
+        SDL_SetWindowTitle(window, replayTitle.c_str());
+    }
+}
+
 void App::update(float dt) {
     if (isFading && state == GameState::MENU) {
         fadeAlpha += fadeSpeed * dt;
@@ -532,6 +611,7 @@ void App::update(float dt) {
 
     if (state == GameState::GAME && !isPaused) {
         server.poll();
+        updateReplayTitle();
 
         if (board && server.getBoardWidth() > 0 && server.getBoardHeight() > 0) {
             board->setBoardSize(server.getBoardWidth(), server.getBoardHeight());
@@ -939,7 +1019,7 @@ bool App::startGame() {
 
     if (inputHostname.empty()) {
         serverHostname = serverHostname;
-    } else if (isValidIPv4(inputHostname)) {
+    } else if (isValidHost(inputHostname)) {
         serverHostname = inputHostname;
     } else {
         serverHostname = "127.0.0.1";
@@ -1226,6 +1306,7 @@ void App::renderHelpScreen() {
                 "• R: Cycle through resolutions (windowed mode)",
                 "• T: Quick theme toggle",
                 "• Arrow Keys: Navigate help pages",
+                "• Replays: Space pause, Up/Down speed, Left/Right seek",
                 "",
                 "VISUAL ELEMENTS:",
                 "• Player squares show team colors and IDs",
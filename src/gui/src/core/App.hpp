@@ -81,6 +81,20 @@ class App {
          */
         void render();
 
+        /**
+         * Handles the playback keys when viewing a recorded match: Space
+         * pauses, Up/Down double or halve the speed, Left/Right and
+         * PageDown/PageUp seek back or forward, Home/End jump to either end.
+         * @param key The pressed key.
+         * @return True if the key controlled the replay.
+         */
+        bool handleReplayKey(SDL_Keycode key);
+
+        /**
+         * Shows the replay position, speed and state in the window title.
+         */
+        void updateReplayTitle();
+
         // --- Rendering Helper Methods ---
 
         /**
@@ -242,6 +256,7 @@ class App {
         bool gameTimerActive = false;
         bool showRealTime = true; // Toggle between real time and game time
         int timeUnit = 100;      // f value from the subject (default 100)
+        std::string replayTitle;
 
         // Pause Menu
         bool isPaused = false;
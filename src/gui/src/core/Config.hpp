@@ -6,6 +6,7 @@
 */
 
 #pragma once
+#include <cstdint>
 #include <vector>
 
 namespace Config {
@@ -34,4 +35,8 @@ namespace Config {
     };
 
     inline constexpr int DEFAULT_RESOLUTION_INDEX = 0;
+
+    // Replay seeks: arrow keys and page keys
+    inline constexpr uint64_t REPLAY_SHORT_SEEK_MS = 30 * 1000;
+    inline constexpr uint64_t REPLAY_LONG_SEEK_MS = 10 * 60 * 1000;
 }
@@ -0,0 +1,422 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ReplayReader
+*/
+
+#include "ReplayReader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Mirrors jrec_t in src/server/include/journal.h
+enum : uint8_t {
+    J_KEYFRAME = 1, J_SPAWN, J_MOVE, J_TAKE, J_SET, J_EAT, J_INC_START,
+    J_INC_END, J_LEVEL, J_EGG_LAY, J_EGG_HATCH, J_EGG_DIE, J_DEATH, J_LEAVE,
+    J_BROADCAST, J_DROP, J_FREQ, J_TYPES
+};
+
+// Fixed fields of each record type, before any variable part
+static const size_t FIELDS[J_TYPES] = {0, 0, 13, 4, 2, 2, 2, 4, 10, 2, 4, 1,
+    1, 1, 1, 2, 3, 1};
+static constexpr uint64_t JOURNAL_VERSION = 3;
+// Varints a keyframe stores per tile, each at least one byte long
+static constexpr uint64_t TILE_FIELDS = 7;
+// Any frequency a journal holds still announces as sgt at every speed
+static constexpr uint64_t FREQ_MAX = 1000000;
+// A caller that stalls (paused menu, slow frame) does not skip ahead
+static constexpr uint64_t STEP_MAX_MS = 250;
+
+ReplayReader::~ReplayReader() {
+    if (_map)
+        munmap(_map, _mapLen);
+}
+
+bool ReplayReader::readVarint(size_t &pos, uint64_t &v) const {
+    v = 0;
+    for (unsigned shift = 0; pos < _len && shift < 64; shift += 7) {
+        uint8_t byte = _data[pos++];
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return true;
+    }
+    return false;
+}
+
+bool ReplayReader::readFields(size_t &pos, size_t n) {
+    uint64_t v;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!readVarint(pos, v))
+            return false;
+        _fields.push_back(v);
+    }
+    return true;
+}
+
+bool ReplayReader::parseHeader(size_t &pos) {
+    if (_len < 4 || memcmp(_data, "ZJNL", 4) != 0)
+        return false;
+    pos = 4;
+    _fields.clear();
+    if (!readFields(pos, 7) || _fields[0] != JOURNAL_VERSION ||
+        _fields[1] == 0 || _fields[2] == 0)
+        return false;
+    // A map whose first keyframe cannot fit in the file is corrupt: reject
+    // it before anything is sized from it
+    if (_fields[1] > _len || _fields[2] > _len / _fields[1] / TILE_FIELDS)
+        return false;
+    _width = static_cast<int>(_fields[1]);
+    _height = static_cast<int>(_fields[2]);
+    _freq = static_cast<int>(std::clamp<uint64_t>(_fields[3], 1, FREQ_MAX));
+    for (uint64_t i = 0, count = _fields[6]; i < count; ++i) {
+        uint64_t n;
+        if (!readVarint(pos, n) || n > _len - pos)
+            return false;
+        _teams.emplace_back(reinterpret_cast<const char *>(_data + pos), n);
+        pos += n;
+    }
+    return true;
+}
+
+bool ReplayReader::decodeKeyframe(size_t &pos) {
+    uint64_t count;
+    size_t tiles = static_cast<size_t>(_width) * _height;
+
+    if (!readVarint(pos, count) || tiles > (_len - pos) / TILE_FIELDS)
+        return false;
+    _freq = static_cast<int>(std::clamp<uint64_t>(count, 1, FREQ_MAX));
+    _tiles.assign(tiles, {});
+    for (auto &tile : _tiles) {
+        for (auto &q : tile)
+            if (!readVarint(pos, q))
+                return false;
+    }
+    _players.clear();
+    if (!readVarint(pos, count))
+        return false;
+    for (uint64_t i = 0; i < count; ++i) {
+        _fields.clear();
+        if (!readFields(pos, 13))
+            return false;
+        Player &p = _players[_fields[0]];
+        p = {static_cast<int>(_fields[1]), static_cast<int>(_fields[2]),
+            static_cast<int>(_fields[3]), static_cast<int>(_fields[4]),
+            static_cast<size_t>(_fields[5]), {}};
+        std::copy(_fields.begin() + 6, _fields.end(), p.inv.begin());
+    }
+    _eggs.clear();
+    if (!readVarint(pos, count))
+        return false;
+    for (uint64_t i = 0; i < count; ++i) {
+        _fields.clear();
+        if (!readFields(pos, 4))
+            return false;
+        _eggs[_fields[0]] = {static_cast<int>(_fields[1]),
+            static_cast<int>(_fields[2])};
+    }
+    return true;
+}
+
+bool ReplayReader::decode(size_t &pos, uint8_t &type, uint64_t &at) {
+    uint64_t dt;
+
+    if (pos >= _len || _data[pos] == 0 || _data[pos] >= J_TYPES)
+        return false;
+    type = _data[pos++];
+    if (!readVarint(pos, dt))
+        return false;
+    at += dt;
+    _fields.clear();
+    if (type == J_KEYFRAME)
+        return decodeKeyframe(pos);
+    if (!readFields(pos, FIELDS[type]))
+        return false;
+    if (type == J_INC_START)
+        return readFields(pos, _fields[3]);
+    if (type != J_BROADCAST)
+        return true;
+    if (_fields[1] > _len - pos)
+        return false;
+    _text.assign(reinterpret_cast<const char *>(_data + pos), _fields[1]);
+    pos += _fields[1];
+    return true;
+}
+
+void ReplayReader::index(size_t pos) {
+    uint64_t at = 0;
+    uint8_t type;
+    size_t start = pos;
+
+    while (decode(pos, type, at)) {
+        if (type == J_KEYFRAME)
+            _keyframes.push_back({at, start});
+        _duration = at;
+        start = pos;
+    }
+    // Whatever follows the last whole record is a write cut short
+    _len = start;
+}
+
+bool ReplayReader::open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st {};
+    size_t pos = 0;
+
+    if (fd == -1)
+        return false;
+    if (fstat(fd, &st) == -1 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    _mapLen = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, _mapLen, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    _map = map;
+    _data = static_cast<const uint8_t *>(map);
+    _len = _mapLen;
+    if (!parseHeader(pos))
+        return false;
+    index(pos);
+    if (_keyframes.empty())
+        return false;
+    seek(0);
+    return true;
+}
+
+void ReplayReader::seek(uint64_t ms) {
+    uint64_t target = std::min(ms, _duration);
+    auto it = std::upper_bound(_keyframes.begin(), _keyframes.end(), target,
+        [](uint64_t t, const Keyframe &k) { return t < k.at; });
+    const Keyframe &kf = it == _keyframes.begin() ? *it : *(it - 1);
+    uint8_t type;
+    uint64_t at = 0;
+
+    _pos = kf.offset;
+    decode(_pos, type, at);
+    _at = kf.at;
+    while (_pos < _len) {
+        size_t next = _pos + 1;
+        uint64_t dt;
+        if (!readVarint(next, dt) || _at + dt > target)
+            break;
+        decode(_pos, type, _at);
+        apply(type, nullptr);
+    }
+    _clock = std::max(target, _at);
+    _resync = true;
+}
+
+void ReplayReader::setSpeed(int speed) {
+    _speed = std::clamp(speed, 1, MAX_SPEED);
+    _speedChanged = true;
+}
+
+ReplayReader::Status ReplayReader::read(std::string &out, uint64_t nowMs,
+    size_t max) {
+    uint64_t step = _lastNow && nowMs > _lastNow ? nowMs - _lastNow : 0;
+    size_t before = out.size();
+    uint8_t type;
+
+    _lastNow = nowMs;
+    if (!_data)
+        return Status::IDLE;
+    if (!_paused)
+        _clock = std::min(_duration,
+            _clock + std::min(step, STEP_MAX_MS) * static_cast<uint64_t>(_speed));
+    if (_resync) {
+        _resync = false;
+        _speedChanged = false;
+        snapshot(out);
+        return Status::RESYNC;
+    }
+    if (_speedChanged) {
+        out += "sgt " + std::to_string(_freq * _speed) + "\n";
+        _speedChanged = false;
+    }
+    while (_pos < _len && out.size() - before < max) {
+        size_t next = _pos + 1;
+        uint64_t dt;
+        if (!readVarint(next, dt) || _at + dt > _clock)
+            break;
+        decode(_pos, type, _at);
+        apply(type, &out);
+    }
+    return out.size() > before ? Status::DATA : Status::IDLE;
+}
+
+static std::string num(uint64_t v) {
+    return std::to_string(v);
+}
+
+void ReplayReader::appendTile(std::string &out, int x, int y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+        return;
+    out += "bct " + std::to_string(x) + " " + std::to_string(y);
+    for (uint64_t q : _tiles[static_cast<size_t>(y) * _width + x])
+        out += " " + num(q);
+    out += "\n";
+}
+
+void ReplayReader::appendInventory(std::string &out, uint64_t id) const {
+    auto it = _players.find(id);
+
+    if (it == _players.end())
+        return;
+    out += "pin #" + num(id) + " " + std::to_string(it->second.x) + " " +
+        std::to_string(it->second.y);
+    for (uint64_t q : it->second.inv)
+        out += " " + num(q);
+    out += "\n";
+}
+
+void ReplayReader::applyItem(uint8_t type, std::string *out) {
+    auto it = _players.find(_fields[0]);
+    size_t res = static_cast<size_t>(_fields[1]);
+
+    if (it == _players.end() || res >= 7)
+        return;
+    Player &p = it->second;
+    if (p.x < 0 || p.y < 0 || p.x >= _width || p.y >= _height)
+        return;
+    auto &tile = _tiles[static_cast<size_t>(p.y) * _width + p.x];
+    uint64_t &from = type == J_TAKE ? tile[res] : p.inv[res];
+    uint64_t &to = type == J_TAKE ? p.inv[res] : tile[res];
+    from -= from > 0;
+    ++to;
+    if (!out)
+        return;
+    *out += (type == J_TAKE ? "pgt #" : "pdr #") + num(_fields[0]) + " " +
+        num(res) + "\n";
+    appendInventory(*out, _fields[0]);
+    appendTile(*out, p.x, p.y);
+}
+
+void ReplayReader::apply(uint8_t type, std::string *out) {
+    const std::vector<uint64_t> &f = _fields;
+    std::string line;
+
+    switch (type) {
+        case J_SPAWN: {
+            Player &p = _players[f[0]];
+            p = {static_cast<int>(f[1]), static_cast<int>(f[2]),
+                static_cast<int>(f[3]), static_cast<int>(f[4]),
+                static_cast<size_t>(f[5]), {}};
+            std::copy(f.begin() + 6, f.end(), p.inv.begin());
+            line = "pnw #" + num(f[0]) + " " + num(f[1]) + " " + num(f[2]) +
+                " " + num(f[3]) + " " + num(f[4]) + " " +
+                (p.team < _teams.size() ? _teams[p.team] : "") + "\n";
+            break;
+        }
+        case J_MOVE: {
+            auto it = _players.find(f[0]);
+            if (it == _players.end())
+                return;
+            it->second.x = static_cast<int>(f[1]);
+            it->second.y = static_cast<int>(f[2]);
+            it->second.orientation = static_cast<int>(f[3]);
+            line = "ppo #" + num(f[0]) + " " + num(f[1]) + " " + num(f[2]) +
+                " " + num(f[3]) + "\n";
+            break;
+        }
+        case J_TAKE:
+        case J_SET:
+            applyItem(type, out);
+            return;
+        case J_EAT: {
+            auto it = _players.find(f[0]);
+            if (it == _players.end())
+                return;
+            it->second.inv[0] -= std::min(it->second.inv[0], f[1]);
+            break;
+        }
+        case J_INC_START:
+            line = "pic " + num(f[0]) + " " + num(f[1]) + " " + num(f[2]);
+            for (size_t i = 4; i < f.size(); ++i)
+                line += " #" + num(f[i]);
+            line += "\n";
+            break;
+        case J_INC_END:
+            if (f[0] < static_cast<uint64_t>(_width) &&
+                f[1] < static_cast<uint64_t>(_height))
+                std::copy(f.begin() + 3, f.end(),
+                    _tiles[f[1] * _width + f[0]].begin());
+            line = "pie " + num(f[0]) + " " + num(f[1]) + " " + num(f[2]) +
+                "\n";
+            break;
+        case J_LEVEL: {
+            auto it = _players.find(f[0]);
+            if (it != _players.end())
+                it->second.level = static_cast<int>(f[1]);
+            line = "plv #" + num(f[0]) + " " + num(f[1]) + "\n";
+            break;
+        }
+        case J_EGG_LAY:
+            _eggs[f[0]] = {static_cast<int>(f[2]), static_cast<int>(f[3])};
+            line = "pfk #" + num(f[1]) + "\nenw #" + num(f[0]) + " #" +
+                num(f[1]) + " " + num(f[2]) + " " + num(f[3]) + "\n";
+            break;
+        case J_EGG_HATCH:
+        case J_EGG_DIE:
+            _eggs.erase(f[0]);
+            line = (type == J_EGG_HATCH ? "ebo #" : "edi #") + num(f[0]) +
+                "\n";
+            break;
+        case J_DEATH:
+        case J_LEAVE:
+            // A starving player is logged as dead, then as gone
+            if (_players.erase(f[0]) == 0)
+                return;
+            line = "pdi #" + num(f[0]) + "\n";
+            break;
+        case J_BROADCAST:
+            line = "pbc #" + num(f[0]) + " " + _text + "\n";
+            break;
+        case J_DROP:
+            if (f[0] >= static_cast<uint64_t>(_width) ||
+                f[1] >= static_cast<uint64_t>(_height) || f[2] >= 7)
+                return;
+            ++_tiles[f[1] * _width + f[0]][f[2]];
+            break;
+        case J_FREQ:
+            _freq = static_cast<int>(std::clamp<uint64_t>(f[0], 1, FREQ_MAX));
+            line = "sgt " + std::to_string(_freq * _speed) + "\n";
+            break;
+        default:
+            return;
+    }
+    if (!out)
+        return;
+    *out += line;
+    if (type == J_SPAWN || type == J_EAT)
+        appendInventory(*out, f[0]);
+    if (type == J_INC_END || type == J_DROP)
+        appendTile(*out, static_cast<int>(f[0]), static_cast<int>(f[1]));
+}
+
+void ReplayReader::snapshot(std::string &out) const {
+    out = "msz " + std::to_string(_width) + " " + std::to_string(_height) +
+        "\nsgt " + std::to_string(_freq * _speed) + "\n";
+    for (const auto &team : _teams)
+        out += "tna " + team + "\n";
+    for (int y = 0; y < _height; ++y)
+        for (int x = 0; x < _width; ++x)
+            appendTile(out, x, y);
+    for (const auto &[id, p] : _players) {
+        out += "pnw #" + num(id) + " " + std::to_string(p.x) + " " +
+            std::to_string(p.y) + " " + std::to_string(p.orientation) + " " +
+            std::to_string(p.level) + " " +
+            (p.team < _teams.size() ? _teams[p.team] : "") + "\n";
+        appendInventory(out, id);
+    }
+    // The journal does not keep who laid an egg
+    for (const auto &[id, egg] : _eggs)
+        out += "enw #" + num(id) + " #-1 " + std::to_string(egg.x) + " " +
+            std::to_string(egg.y) + "\n";
+}
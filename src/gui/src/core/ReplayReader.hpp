@@ -0,0 +1,146 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ReplayReader
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Plays back a match journal recorded by zappy_server -j.
+ * The journal is mapped read-only and turned back into the GUI protocol, so
+ * the viewer's model consumes it like a live feed. Opening the file indexes
+ * its keyframes; a seek restores the closest keyframe before the target and
+ * applies the few records after it, instead of replaying from the start.
+ * The record layout is documented in src/server/include/journal.h.
+ */
+class ReplayReader {
+    public:
+        /**
+         * Outcome of a read, as for ShmFeed.
+         */
+        enum class Status {
+            IDLE,   // No record is due yet
+            DATA,   // Lines were appended to the output
+            RESYNC  // The output was replaced by a snapshot
+        };
+
+        static constexpr int MAX_SPEED = 64;
+
+        ReplayReader() = default;
+        ReplayReader(const ReplayReader &) = delete;
+        ReplayReader &operator=(const ReplayReader &) = delete;
+
+        /**
+         * Unmaps the journal.
+         */
+        ~ReplayReader();
+
+        /**
+         * Maps a journal and indexes its keyframes; playback starts at the
+         * first keyframe.
+         * @param path The journal file.
+         * @return True if the file is a journal this reader understands.
+         * @note A journal cut short by a crash plays up to its last whole record.
+         */
+        bool open(const std::string &path);
+
+        /**
+         * Advances the playback clock and emits the records that became due.
+         * @param out The buffer receiving protocol lines; replaced on RESYNC.
+         * @param nowMs A monotonic time in milliseconds.
+         * @param max Stop once about that many bytes were appended.
+         * @return What happened, see Status.
+         */
+        Status read(std::string &out, uint64_t nowMs, size_t max);
+
+        /**
+         * Moves playback to a match time; the next read returns a snapshot.
+         * @param ms Milliseconds since the start of the match, clamped.
+         */
+        void seek(uint64_t ms);
+
+        /**
+         * Pauses or resumes playback.
+         */
+        void togglePause() { _paused = !_paused; }
+
+        /**
+         * Sets the playback speed; the next read announces it with sgt.
+         * @param speed The speed factor, clamped between 1 and MAX_SPEED.
+         */
+        void setSpeed(int speed);
+
+        bool isPaused() const { return _paused; }
+        int getSpeed() const { return _speed; }
+        uint64_t getPosition() const { return _clock; }
+        uint64_t getDuration() const { return _duration; }
+        size_t getKeyframeCount() const { return _keyframes.size(); }
+
+    private:
+        struct Player {
+            int x;
+            int y;
+            int orientation;
+            int level;
+            size_t team;
+            std::array<uint64_t, 7> inv;
+        };
+
+        struct Egg {
+            int x;
+            int y;
+        };
+
+        struct Keyframe {
+            uint64_t at;
+            size_t offset;
+        };
+
+        bool readVarint(size_t &pos, uint64_t &v) const;
+        bool readFields(size_t &pos, size_t n);
+        bool parseHeader(size_t &pos);
+        bool decode(size_t &pos, uint8_t &type, uint64_t &at);
+        bool decodeKeyframe(size_t &pos);
+        void index(size_t pos);
+        void apply(uint8_t type, std::string *out);
+        void applyItem(uint8_t type, std::string *out);
+        void snapshot(std::string &out) const;
+        void appendTile(std::string &out, int x, int y) const;
+        void appendInventory(std::string &out, uint64_t id) const;
+
+        void *_map{nullptr};
+        size_t _mapLen{0};
+        const uint8_t *_data{nullptr};
+        size_t _len{0};
+
+        int _width{0};
+        int _height{0};
+        int _freq{1};
+        std::vector<std::string> _teams;
+        std::vector<Keyframe> _keyframes;
+        uint64_t _duration{0};
+
+        std::vector<uint64_t> _fields;
+        std::string _text;
+        std::vector<std::array<uint64_t, 7>> _tiles;
+        std::map<uint64_t, Player> _players;
+        std::map<uint64_t, Egg> _eggs;
+
+        size_t _pos{0};
+        uint64_t _at{0};
+        uint64_t _clock{0};
+        uint64_t _lastNow{0};
+        int _speed{1};
+        bool _paused{false};
+        bool _resync{true};
+        bool _speedChanged{false};
+};
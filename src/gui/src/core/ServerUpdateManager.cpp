@@ -6,17 +6,28 @@
 */
 
 #include "ServerUpdateManager.hpp"
+#include "ShmFeed.hpp"
+#include "ReplayReader.hpp"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h> 
 #include <unistd.h>
 #include <fcntl.h>
+#include <cerrno>
 #include <cstring>
 #include <cstdio>
 #include <iostream>
 #include <unordered_map>
+#include <algorithm>
 #include <sys/select.h>
+#include <sys/un.h>
+#include <chrono>
+
+static const std::string UNIX_PREFIX = "unix:";
+static const std::string SHM_PREFIX = "shm:";
+static const std::string REPLAY_PREFIX = "replay:";
+static constexpr size_t SHM_POLL_MAX = 1 << 20;
 
 ServerUpdateManager::ServerUpdateManager(const std::string& host, uint16_t port)
     : _host(host), _port(port) {}
@@ -26,11 +37,64 @@ ServerUpdateManager::~ServerUpdateManager() {
         close(_sock);
 }
 
+int ServerUpdateManager::connectUnix(const std::string &path) {
+    sockaddr_un addr{};
+    int fd;
+
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return -1;
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        perror("socket");
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+        perror("connect");
+        close(fd);
+        return -1;
+    }
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags != -1)
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    return fd;
+}
+
 bool ServerUpdateManager::connect() {
-    if (_sock != -1) {
+    if (_sock != -1 || _shm || _replay) {
         disconnect();
     }
 
+    if (_host.rfind(REPLAY_PREFIX, 0) == 0) {
+        auto replay = std::make_shared<ReplayReader>();
+        if (!replay->open(_host.substr(REPLAY_PREFIX.size()))) {
+            std::cerr << "Cannot open match journal: " << _host << std::endl;
+            return false;
+        }
+        _replay = replay;
+        return true;
+    }
+
+    if (_host.rfind(SHM_PREFIX, 0) == 0) {
+        auto feed = std::make_shared<ShmFeed>();
+        if (!feed->open(_host.substr(SHM_PREFIX.size()))) {
+            std::cerr << "Cannot open shared-memory feed: " << _host << std::endl;
+            return false;
+        }
+        _shm = feed;
+        return true;
+    }
+    if (_host.rfind(UNIX_PREFIX, 0) == 0) {
+        _sock = connectUnix(_host.substr(UNIX_PREFIX.size()));
+        if (_sock == -1)
+            return false;
+        ::send(_sock, "GRAPHIC\n", 8, MSG_NOSIGNAL);
+        return true;
+    }
+
     _sock = socket(AF_INET, SOCK_STREAM, 0);
     if (_sock == -1) {
         perror("socket");
@@ -96,8 +160,11 @@ void ServerUpdateManager::disconnect() {
         close(_sock);
         _sock = -1;
     }
+    _shm.reset();
+    _replay.reset();
     
     _readBuffer.clear();
+    _writeBuffer.clear();
     _boardWidth = 0;
     _boardHeight = 0;
     _teamNames.clear();
@@ -108,7 +175,59 @@ void ServerUpdateManager::disconnect() {
     _broadcasts.clear();
 }
 
+void ServerUpdateManager::consumeLines() {
+    size_t pos;
+
+    while ((pos = _readBuffer.find('\n')) != std::string::npos) {
+        std::string line = _readBuffer.substr(0, pos);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        processLine(line);
+        if (_lineObserver)
+            _lineObserver(line);
+        _readBuffer.erase(0, pos + 1);
+    }
+}
+
+void ServerUpdateManager::pollShm() {
+    size_t budget = SHM_POLL_MAX;
+
+    while (budget > 0) {
+        size_t before = _readBuffer.size();
+        ShmFeed::Status status = _shm->read(_readBuffer, budget);
+        if (status == ShmFeed::Status::IDLE)
+            break;
+        // On RESYNC the buffer holds a keyframe, whose msz resets the model
+        if (status == ShmFeed::Status::RESYNC)
+            before = 0;
+        budget -= std::min(budget, _readBuffer.size() - before);
+        consumeLines();
+    }
+}
+
+void ServerUpdateManager::pollReplay() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    uint64_t nowMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+
+    // On RESYNC the buffer holds a snapshot, whose msz resets the model
+    if (_replay->read(_readBuffer, nowMs, SHM_POLL_MAX) !=
+        ReplayReader::Status::IDLE)
+        consumeLines();
+}
+
 void ServerUpdateManager::poll() {
+    if (_replay) {
+        pollReplay();
+        return;
+    }
+    if (_shm) {
+        pollShm();
+        return;
+    }
+    if (_sock == -1)
+        return;
+    flushWrites();
     if (_sock == -1)
         return;
 
@@ -116,26 +235,62 @@ void ServerUpdateManager::poll() {
     ssize_t n = recv(_sock, buf, sizeof(buf), 0);
     while (n > 0) {
         _readBuffer.append(buf, n);
-        size_t pos;
-        while ((pos = _readBuffer.find('\n')) != std::string::npos) {
-            std::string line = _readBuffer.substr(0, pos);
-            if (!line.empty() && line.back() == '\r')
-                line.pop_back();
-            processLine(line);
-            _readBuffer.erase(0, pos + 1);
-        }
+        consumeLines();
         n = recv(_sock, buf, sizeof(buf), 0);
     }
+    // EOF or a hard error: drop the socket so callers see the disconnect
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        close(_sock);
+        _sock = -1;
+    }
+}
+
+bool ServerUpdateManager::sendRaw(const std::string &line) {
+    if (_sock == -1)
+        return false;
+    _writeBuffer += line;
+    flushWrites();
+    return _sock != -1;
+}
+
+bool ServerUpdateManager::flushWrites() {
+    size_t sent = 0;
+
+    while (_sock != -1 && sent < _writeBuffer.size()) {
+        ssize_t n = ::send(_sock, _writeBuffer.data() + sent,
+            _writeBuffer.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n == -1 && errno == EINTR) {
+            continue;
+        } else if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            // Same as a failed recv: drop the socket so callers see it
+            close(_sock);
+            _sock = -1;
+        }
+    }
+    _writeBuffer.erase(0, sent);
+    return _writeBuffer.empty();
 }
 
 void ServerUpdateManager::processLine(const std::string& line) {
     if (line.rfind("msz", 0) == 0) {
         int w, h;
         if (sscanf(line.c_str(), "msz %d %d", &w, &h) == 2) {
+            // msz opens a full snapshot (initial or resync after a backlog overflow)
             _boardWidth = w;
             _boardHeight = h;
             _resources.assign(_boardWidth * _boardHeight, {});
+            _teamNames.clear();
+            _players.clear();
+            _eggs.clear();
         }
+    } else if (line.rfind("sgt", 0) == 0 || line.rfind("sst", 0) == 0) {
+        int t;
+        if (sscanf(line.c_str() + 3, " %d", &t) == 1)
+            _timeUnit = t;
     } else if (line.rfind("tna", 0) == 0) {
         size_t spacePos = line.find(' ');
         if (spacePos != std::string::npos && spacePos + 1 < line.size()) {
@@ -206,11 +361,9 @@ void ServerUpdateManager::processLine(const std::string& line) {
         
     } else if (line.rfind("ebo", 0) == 0) {
         int eggId;
-        if (sscanf(line.c_str(), "ebo #%d", &eggId) == 1) {
-            auto eggIt = _eggs.find(eggId);
-            if (eggIt != _eggs.end()) {
-            }
-        }
+        // The egg hatched: a player took its place
+        if (sscanf(line.c_str(), "ebo #%d", &eggId) == 1)
+            _eggs.erase(eggId);
         
     } else if (line.rfind("edi", 0) == 0) {
         int eggId;
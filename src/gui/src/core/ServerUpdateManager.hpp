@@ -8,10 +8,15 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class ShmFeed;
+class ReplayReader;
+
 class ServerUpdateManager {
     public:
         // --- Nested Structs and Enums ---
@@ -90,8 +95,11 @@ class ServerUpdateManager {
 
         /**
          * Constructor that initializes the server update manager with a host and port.
-         * @param host The hostname or IP address of the server.
-         * @param port The port number to connect to.
+         * @param host The hostname or IP address of the server, "unix:/path" for
+         * the server's AF_UNIX listener, "shm:name" for its shared-memory feed
+         * or "replay:/path" for a match journal recorded with zappy_server -j.
+         * @param port The port number to connect to (ignored by unix:, shm: and
+         * replay:).
          */
         ServerUpdateManager(const std::string &host, uint16_t port);
 
@@ -119,6 +127,58 @@ class ServerUpdateManager {
          */
         void poll();
 
+        /**
+         * Returns whether the upstream socket or shared-memory feed is open.
+         * @return True while connected to the server.
+         */
+        bool isConnected() const {
+            return _sock != -1 || _shm != nullptr || _replay != nullptr;
+        }
+
+        /**
+         * Returns the playback controls when reading a recorded match.
+         * @return The replay, or nullptr when following a live server.
+         */
+        ReplayReader *getReplay() const { return _replay.get(); }
+
+        /**
+         * Returns the upstream socket, for callers multiplexing it themselves.
+         * @return The socket file descriptor, or -1 when disconnected or reading
+         * the shared-memory feed.
+         */
+        int getSocket() const { return _sock; }
+
+        /**
+         * Sends a raw protocol line to the server.
+         * @param line The line to send, including its trailing newline.
+         * @return True if the line was written or queued; always false on the
+         * shared-memory feed and on replays, which are one-way.
+         * @note What the socket cannot take at once is kept and sent by the
+         * next poll() or flushWrites(), so a line is never cut short.
+         */
+        bool sendRaw(const std::string &line);
+
+        /**
+         * Sends as much of the queued output as the socket takes.
+         * @return True once nothing is left to send.
+         */
+        bool flushWrites();
+
+        /**
+         * Returns whether output is waiting for the socket to become writable.
+         * @return True if the caller should poll the socket for POLLOUT.
+         */
+        bool hasPendingWrites() const { return !_writeBuffer.empty(); }
+
+        /**
+         * Registers a callback invoked with every line once it has been applied
+         * to the model. Used by the relay to fan the stream out to its viewers.
+         * @param observer The callback, or an empty function to remove it.
+         */
+        void setLineObserver(std::function<void(const std::string &)> observer) {
+            _lineObserver = std::move(observer);
+        }
+
         // --- Board Information Getters ---
 
         /**
@@ -250,12 +310,37 @@ class ServerUpdateManager {
          */
         void processLine(const std::string &line);
 
+        /**
+         * Applies every complete line accumulated in the read buffer.
+         */
+        void consumeLines();
+
+        /**
+         * Connects to the server's AF_UNIX listener.
+         * @param path The socket path.
+         * @return The connected socket, or -1 on failure.
+         */
+        int connectUnix(const std::string &path);
+
+        /**
+         * Drains the shared-memory feed into the read buffer.
+         */
+        void pollShm();
+
+        /**
+         * Applies the replayed records that are due by the playback clock.
+         */
+        void pollReplay();
+
         // --- Private Members ---
 
         std::string _host;
         uint16_t _port;
         int _sock{-1};
+        std::shared_ptr<ShmFeed> _shm;
+        std::shared_ptr<ReplayReader> _replay;
         std::string _readBuffer;
+        std::string _writeBuffer;
 
         int _boardWidth{0};
         int _boardHeight{0};
@@ -267,4 +352,5 @@ class ServerUpdateManager {
         int _timeUnit{0};
         std::vector<Broadcast> _broadcasts;
         std::vector<Event> _events;
+        std::function<void(const std::string &)> _lineObserver;
 };
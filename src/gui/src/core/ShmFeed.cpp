@@ -0,0 +1,99 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ShmFeed
+*/
+
+#include "ShmFeed.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+    "the shared-memory feed needs lock-free 64-bit atomics");
+
+ShmFeed::~ShmFeed() {
+    if (_map)
+        munmap(_map, _mapLen);
+}
+
+bool ShmFeed::open(const std::string &name) {
+    std::string path = name.empty() || name[0] != '/' ? "/" + name : name;
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    struct stat st {};
+
+    if (fd == -1)
+        return false;
+    if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) <= HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+    _mapLen = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, _mapLen, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+    _map = map;
+    _hdr = static_cast<const Header *>(_map);
+    _data = static_cast<const char *>(_map) + HEADER_SIZE;
+    return _hdr->magic.load(std::memory_order_acquire) == MAGIC &&
+        _hdr->version == VERSION &&
+        HEADER_SIZE + _hdr->capacity + 2 * _hdr->kfCapacity <= _mapLen;
+}
+
+ShmFeed::Status ShmFeed::loadKeyframe(std::string &out) {
+    uint64_t seq = _hdr->kfSeq.load(std::memory_order_acquire);
+    size_t slot = seq & 1;
+
+    if (seq < _minSeq)
+        return Status::IDLE;
+    uint64_t at = _hdr->kfAt[slot];
+    uint64_t len = std::min(_hdr->kfLen[slot], _hdr->kfCapacity);
+    std::string frame(_data + _hdr->capacity + slot * _hdr->kfCapacity, len);
+
+    // The writer fills the other slot; ours is only reused two keyframes later
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_hdr->kfReserve.load(std::memory_order_relaxed) > seq + 1)
+        return Status::IDLE;
+    if (_hdr->reserve.load(std::memory_order_relaxed) - at > _hdr->capacity) {
+        // The deltas following this keyframe are gone already: wait for a newer one
+        _minSeq = seq + 1;
+        return Status::IDLE;
+    }
+    out = std::move(frame);
+    _pos = at;
+    _needKeyframe = false;
+    return Status::RESYNC;
+}
+
+ShmFeed::Status ShmFeed::read(std::string &out, size_t max) {
+    if (!_hdr)
+        return Status::IDLE;
+    if (_needKeyframe)
+        return loadKeyframe(out);
+    uint64_t cap = _hdr->capacity;
+    uint64_t head = _hdr->head.load(std::memory_order_acquire);
+    if (head == _pos)
+        return Status::IDLE;
+
+    size_t n = static_cast<size_t>(std::min<uint64_t>(head - _pos, max));
+    size_t at = static_cast<size_t>(_pos & (cap - 1));
+    size_t first = std::min<size_t>(n, static_cast<size_t>(cap) - at);
+    size_t oldSize = out.size();
+    out.append(_data + at, first);
+    out.append(_data, n - first);
+
+    // Seqlock check: if the writer started overwriting our range, we were lapped
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_hdr->reserve.load(std::memory_order_relaxed) - _pos > cap) {
+        out.resize(oldSize);
+        _needKeyframe = true;
+        _minSeq = 1;
+        return loadKeyframe(out);
+    }
+    _pos += n;
+    return Status::DATA;
+}
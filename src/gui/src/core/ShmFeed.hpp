@@ -0,0 +1,87 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ShmFeed
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Read-only view of the shared-memory GUI feed published by zappy_server -m.
+ * The server writes the same lines it sends to GUI sockets into a ring, and
+ * periodically stores a full snapshot (keyframe) next to it. A reader that
+ * falls a whole ring behind reloads the latest keyframe instead of reading
+ * torn data, then resumes the ring where that keyframe was taken.
+ */
+class ShmFeed {
+    public:
+        /**
+         * Outcome of a read.
+         */
+        enum class Status {
+            IDLE,   // Nothing new was published
+            DATA,   // Bytes were appended to the output
+            RESYNC  // The output was replaced by a keyframe
+        };
+
+        ShmFeed() = default;
+        ShmFeed(const ShmFeed &) = delete;
+        ShmFeed &operator=(const ShmFeed &) = delete;
+
+        /**
+         * Unmaps the segment.
+         */
+        ~ShmFeed();
+
+        /**
+         * Maps the feed; the first read returns the latest keyframe.
+         * @param name The POSIX shared memory name, with or without leading '/'.
+         * @return True if the segment exists and has the expected layout.
+         */
+        bool open(const std::string &name);
+
+        /**
+         * Reads the next published bytes.
+         * @param out The buffer receiving the stream; replaced on RESYNC.
+         * @param max The maximum number of bytes to append.
+         * @return What happened, see Status.
+         */
+        Status read(std::string &out, size_t max);
+
+    private:
+        /**
+         * Mirrors gui_ring_hdr_t in src/server/include/gui_ring.h.
+         */
+        struct Header {
+            std::atomic<uint32_t> magic;
+            uint32_t version;
+            uint64_t capacity;
+            uint64_t kfCapacity;
+            std::atomic<uint64_t> head;
+            std::atomic<uint64_t> reserve;
+            std::atomic<uint64_t> kfSeq;
+            std::atomic<uint64_t> kfReserve;
+            uint64_t kfAt[2];
+            uint64_t kfLen[2];
+        };
+
+        static constexpr uint32_t MAGIC = 0x5a52494eU;
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 128;
+
+        Status loadKeyframe(std::string &out);
+
+        void *_map{nullptr};
+        size_t _mapLen{0};
+        const Header *_hdr{nullptr};
+        const char *_data{nullptr};
+        uint64_t _pos{0};
+        bool _needKeyframe{true};
+        uint64_t _minSeq{1};
+};
@@ -12,7 +12,7 @@
 #include <cstring>
 #include <regex>
 
-bool isValidIPv4(const std::string& ip);
+bool isValidHost(const std::string& host);
 
 struct GuiConfig {
     int port = 4242;
@@ -23,7 +23,8 @@ void printUsage(const char* programName) {
     std::cout << "USAGE: " << programName << " -p port -h machine" << std::endl;
     std::cout << "option description" << std::endl;
     std::cout << "-p port        port number" << std::endl;
-    std::cout << "-h machine     hostname of the server" << std::endl;
+    std::cout << "-h machine     hostname of the server, unix:/path, shm:name" << std::endl;
+    std::cout << "               or replay:/path to play a match journal" << std::endl;
 }
 
 bool parseArguments(int argc, char* argv[], GuiConfig& config) {
@@ -55,10 +56,10 @@ bool parseArguments(int argc, char* argv[], GuiConfig& config) {
                 return false;
             }
             std::string hostname = argv[i + 1];
-            if (isValidIPv4(hostname)) {
+            if (isValidHost(hostname)) {
                 config.hostname = hostname;
             } else {
-                std::cerr << "Warning: Invalid IPv4 address '" << hostname << "', using 127.0.0.1" << std::endl;
+                std::cerr << "Warning: Invalid host '" << hostname << "', using 127.0.0.1" << std::endl;
                 config.hostname = "127.0.0.1";
             }
             i++;
@@ -21,8 +21,12 @@ class ZappyIA:
     def __init__(self, team="team1", host="localhost", port=4242, verbose=True):
         self.verbose = verbose
         self.team = team
-        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-        self.sock.connect((host, port))
+        if host.startswith("unix:"):
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.connect(host[len("unix:"):])
+        else:
+            self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            self.sock.connect((host, port))
         self._log = (lambda *a, **k: print(*a, **k)) if verbose else (lambda *a, **k: None)
         self.level = 1
         self.inventory_cache = {}
@@ -402,7 +406,7 @@ def _parse_cli():
 
     parser.add_argument("-p", dest="port", type=int, required=True, help="Port number")
     parser.add_argument("-n", dest="team", required=True, help="Team name")
-    parser.add_argument("-h", dest="host", default="localhost", help="Server hostname (default: localhost)")
+    parser.add_argument("-h", dest="host", default="localhost", help="Server hostname, or unix:/path for the server's -u socket (default: localhost)")
 
     parser.add_argument("--quiet", action="store_false", dest="verbose", default=True, help="Mute client logs")
 
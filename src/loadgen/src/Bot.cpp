@@ -0,0 +1,96 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Bot
+*/
+
+#include "Bot.hpp"
+#include <algorithm>
+
+static const std::string MESSAGE_PREFIX = "message ";
+
+Bot::Bot(uint32_t id, Command behaviour, const std::string &team)
+    : id(id), behaviour(behaviour), team(team) {}
+
+void Bot::attach(int fd) {
+    this->fd = fd;
+    state = State::CONNECTING;
+    in.clear();
+    out.clear();
+    wantWrite = false;
+    _inflight.clear();
+    _joinLines = 0;
+}
+
+void Bot::fill(int depth, uint64_t nowUs) {
+    const CommandInfo &info = COMMANDS[static_cast<size_t>(behaviour)];
+
+    if (state != State::PLAYING)
+        return;
+    while (_inflight.size() < static_cast<size_t>(depth)) {
+        std::string payload;
+        if (behaviour == Command::BROADCAST)
+            payload = "lg" + std::to_string(id) + "." + std::to_string(_seq++);
+        out += info.name;
+        out += payload.empty() ? "\n" : " " + payload + "\n";
+        if (_inflight.empty())
+            _lastReplyUs = nowUs;
+        _inflight.push_back({nowUs, std::move(payload)});
+    }
+}
+
+// A pipelined command starts when the previous one is answered
+void Bot::onReply(size_t index, uint64_t nowUs, int freq, Stats &stats) {
+    const Pending &p = _inflight[index];
+    uint64_t start = std::max(p.sentUs, _lastReplyUs);
+    uint64_t nominal = static_cast<uint64_t>(
+        COMMANDS[static_cast<size_t>(behaviour)].cost) * 1000000 / freq;
+    uint64_t busy = nowUs - start;
+
+    stats.record(behaviour, nowUs - p.sentUs, busy > nominal ? busy - nominal : 0);
+    _lastReplyUs = nowUs;
+    _inflight.erase(_inflight.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+Bot::Verdict Bot::onLine(const std::string &line, uint64_t nowUs, int freq,
+    Stats &stats) {
+    switch (state) {
+        case State::WELCOME:
+            if (line == "WELCOME") {
+                out += team + "\n";
+                state = State::JOINING;
+            }
+            return Verdict::KEEP;
+        case State::JOINING:
+            if (line == "ko")
+                return Verdict::REFUSED;
+            if (++_joinLines == 2) {
+                state = State::PLAYING;
+                ++stats.joins;
+            }
+            return Verdict::KEEP;
+        case State::PLAYING:
+            break;
+        default:
+            return Verdict::KEEP;
+    }
+    if (line == "dead")
+        return Verdict::DEAD;
+    // The emitter hears its own broadcast instead of an "ok", not always in
+    // the order the broadcasts were sent
+    if (line.rfind(MESSAGE_PREFIX, 0) == 0) {
+        size_t comma = line.find(", ");
+        for (size_t i = 0; comma != std::string::npos && i < _inflight.size(); ++i)
+            if (!_inflight[i].payload.empty() &&
+                line.compare(comma + 2, std::string::npos, _inflight[i].payload) == 0) {
+                onReply(i, nowUs, freq, stats);
+                break;
+            }
+        return Verdict::KEEP;
+    }
+    if (line.rfind("eject:", 0) == 0 || _inflight.empty())
+        return Verdict::KEEP;
+    onReply(0, nowUs, freq, stats);
+    return Verdict::KEEP;
+}
@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Bot
+*/
+
+#pragma once
+
+#include "Stats.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+/**
+ * One simulated AI client: joins a team, then keeps depth (-q) commands sent
+ * but not yet answered, all of its single behaviour, and times every reply.
+ * The bot only parses the protocol; LoadGen owns its socket and moves bytes.
+ */
+class Bot {
+    public:
+        enum class State {
+            IDLE,        // Not connected, waiting for retryAtUs
+            CONNECTING,  // Non-blocking connect in progress
+            WELCOME,     // Waiting for WELCOME
+            JOINING,     // Team sent, waiting for the slot count and map size
+            PLAYING      // Sending commands
+        };
+
+        /**
+         * Outcome of a protocol line.
+         */
+        enum class Verdict {
+            KEEP,     // Connection stays open
+            REFUSED,  // The team was unknown or full
+            DEAD      // The player starved
+        };
+
+        Bot(uint32_t id, Command behaviour, const std::string &team);
+
+        /**
+         * Resets the protocol state for a new connection.
+         * @param fd The connecting socket.
+         */
+        void attach(int fd);
+
+        /**
+         * Applies one line received from the server.
+         * @param line The line, without its trailing newline.
+         * @param nowUs The monotonic time the line was read, in microseconds.
+         * @param freq The server frequency, to compute lateness.
+         * @param stats Receives the reply's latency.
+         * @return Whether the connection should stay open.
+         */
+        Verdict onLine(const std::string &line, uint64_t nowUs, int freq,
+            Stats &stats);
+
+        /**
+         * Queues commands until depth of them are in flight.
+         * @param depth The pipeline depth, at most the server's 10.
+         * @param nowUs The monotonic time, in microseconds.
+         */
+        void fill(int depth, uint64_t nowUs);
+
+        uint32_t id;
+        Command behaviour;
+        std::string team;
+        State state{State::IDLE};
+        int fd{-1};
+        std::string in;
+        std::string out;
+        bool wantWrite{false};
+        uint64_t retryAtUs{0};
+
+    private:
+        struct Pending {
+            uint64_t sentUs;
+            std::string payload;
+        };
+
+        void onReply(size_t index, uint64_t nowUs, int freq, Stats &stats);
+
+        std::deque<Pending> _inflight;
+        uint64_t _lastReplyUs{0};
+        int _joinLines{0};
+        uint64_t _seq{0};
+};
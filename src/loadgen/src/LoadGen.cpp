@@ -0,0 +1,231 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** LoadGen
+*/
+
+#include "LoadGen.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const std::string UNIX_PREFIX = "unix:";
+static constexpr uint64_t RETRY_US = 1000000;
+static constexpr int MAX_EVENTS = 1024;
+static constexpr int TICK_MS = 10;
+static constexpr size_t READ_CHUNK = 64 * 1024;
+
+static uint64_t nowUs() {
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(t).count());
+}
+
+// Thousands of sockets do not fit in the usual soft limit of 1024
+static void raiseFdLimit() {
+    rlimit lim{};
+
+    if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+        lim.rlim_cur = lim.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+}
+
+LoadGen::LoadGen(const LoadConfig &cfg) : _cfg(cfg) {
+    std::vector<Command> pattern;
+
+    for (size_t c = 0; c < static_cast<size_t>(Command::COUNT); ++c)
+        pattern.insert(pattern.end(), static_cast<size_t>(cfg.mix[c]),
+            static_cast<Command>(c));
+    for (int i = 0; i < cfg.clients; ++i)
+        _bots.emplace_back(static_cast<uint32_t>(i),
+            pattern[static_cast<size_t>(i) % pattern.size()],
+            cfg.teams[static_cast<size_t>(i) % cfg.teams.size()]);
+}
+
+LoadGen::~LoadGen() {
+    for (auto &bot : _bots)
+        if (bot.fd != -1)
+            ::close(bot.fd);
+    if (_epfd != -1)
+        ::close(_epfd);
+}
+
+bool LoadGen::resolve() {
+    if (_cfg.host.rfind(UNIX_PREFIX, 0) == 0) {
+        auto *un = reinterpret_cast<sockaddr_un *>(&_addr);
+        std::string path = _cfg.host.substr(UNIX_PREFIX.size());
+        if (path.empty() || path.size() >= sizeof(un->sun_path))
+            return false;
+        un->sun_family = AF_UNIX;
+        memcpy(un->sun_path, path.c_str(), path.size() + 1);
+        _addrLen = sizeof(sockaddr_un);
+        return true;
+    }
+    addrinfo hints{};
+    addrinfo *res = nullptr;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(_cfg.host.c_str(), std::to_string(_cfg.port).c_str(),
+        &hints, &res) != 0 || !res)
+        return false;
+    memcpy(&_addr, res->ai_addr, res->ai_addrlen);
+    _addrLen = res->ai_addrlen;
+    freeaddrinfo(res);
+    return true;
+}
+
+bool LoadGen::open(Bot &bot) {
+    int fd = socket(_addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    epoll_event ev{};
+
+    if (fd == -1)
+        return false;
+    if (_addr.ss_family != AF_UNIX)
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    ev.events = EPOLLIN | EPOLLOUT;
+    ev.data.u64 = bot.id;
+    if ((::connect(fd, reinterpret_cast<sockaddr *>(&_addr), _addrLen) == -1 &&
+        errno != EINPROGRESS) || epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        ::close(fd);
+        return false;
+    }
+    bot.attach(fd);
+    bot.wantWrite = true;
+    ++_stats.connects;
+    return true;
+}
+
+void LoadGen::close(Bot &bot, uint64_t retryAtUs) {
+    if (bot.fd != -1)
+        ::close(bot.fd);
+    bot.fd = -1;
+    bot.state = Bot::State::IDLE;
+    bot.retryAtUs = retryAtUs;
+}
+
+void LoadGen::connectDue(uint64_t now) {
+    uint64_t allowed = (now - _startUs) * static_cast<uint64_t>(_cfg.rate) /
+        1000000 + 1;
+
+    for (auto &bot : _bots) {
+        if (_opened >= allowed)
+            return;
+        if (bot.state != Bot::State::IDLE || bot.retryAtUs > now)
+            continue;
+        ++_opened;
+        if (!open(bot)) {
+            ++_stats.connectFailures;
+            bot.retryAtUs = now + RETRY_US;
+        }
+    }
+}
+
+bool LoadGen::flush(Bot &bot) {
+    while (!bot.out.empty()) {
+        ssize_t n = send(bot.fd, bot.out.data(), bot.out.size(), MSG_NOSIGNAL);
+        if (n == -1 && errno == EINTR)
+            continue;
+        if (n == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            return false;
+        if (n == -1)
+            break;
+        _stats.bytesOut += static_cast<uint64_t>(n);
+        bot.out.erase(0, static_cast<size_t>(n));
+    }
+    bool want = !bot.out.empty();
+    if (want != bot.wantWrite) {
+        epoll_event ev{};
+        ev.events = want ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        ev.data.u64 = bot.id;
+        epoll_ctl(_epfd, EPOLL_CTL_MOD, bot.fd, &ev);
+        bot.wantWrite = want;
+    }
+    return true;
+}
+
+bool LoadGen::readLines(Bot &bot, uint64_t now) {
+    char buf[READ_CHUNK];
+    ssize_t n;
+    size_t pos;
+
+    while ((n = recv(bot.fd, buf, sizeof(buf), 0)) > 0) {
+        _stats.bytesIn += static_cast<uint64_t>(n);
+        bot.in.append(buf, static_cast<size_t>(n));
+    }
+    if (n == 0 || (n == -1 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        ++_stats.disconnects;
+        close(bot, now + RETRY_US);
+        return false;
+    }
+    while ((pos = bot.in.find('\n')) != std::string::npos) {
+        Bot::Verdict v = bot.onLine(bot.in.substr(0, pos), now, _cfg.freq, _stats);
+        bot.in.erase(0, pos + 1);
+        if (v == Bot::Verdict::REFUSED)
+            ++_stats.refused;
+        if (v == Bot::Verdict::DEAD)
+            ++_stats.deaths;
+        if (v != Bot::Verdict::KEEP) {
+            close(bot, v == Bot::Verdict::DEAD ? now : now + RETRY_US);
+            return false;
+        }
+    }
+    bot.fill(_cfg.depth, now);
+    return true;
+}
+
+void LoadGen::onEvent(Bot &bot, uint32_t events, uint64_t now) {
+    if (bot.state == Bot::State::CONNECTING) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (getsockopt(bot.fd, SOL_SOCKET, SO_ERROR, &err, &len) == -1 || err) {
+            ++_stats.connectFailures;
+            close(bot, now + RETRY_US);
+            return;
+        }
+        bot.state = Bot::State::WELCOME;
+    }
+    if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !readLines(bot, now))
+        return;
+    if (!flush(bot)) {
+        ++_stats.disconnects;
+        close(bot, now + RETRY_US);
+    }
+}
+
+bool LoadGen::run(volatile std::sig_atomic_t &stop) {
+    epoll_event events[MAX_EVENTS];
+    uint64_t end;
+
+    if (!resolve()) {
+        std::cerr << "loadgen: cannot resolve " << _cfg.host << std::endl;
+        return false;
+    }
+    raiseFdLimit();
+    _epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epfd == -1)
+        return false;
+    _startUs = nowUs();
+    end = _startUs + static_cast<uint64_t>(_cfg.seconds) * 1000000;
+    for (uint64_t now = _startUs; now < end && !stop; now = nowUs()) {
+        connectDue(now);
+        int n = epoll_wait(_epfd, events, MAX_EVENTS, TICK_MS);
+        now = nowUs();
+        for (int i = 0; i < n; ++i) {
+            Bot &bot = _bots[events[i].data.u64];
+            if (bot.fd != -1)
+                onEvent(bot, events[i].events, now);
+        }
+    }
+    _elapsed = static_cast<double>(nowUs() - _startUs) / 1e6;
+    return true;
+}
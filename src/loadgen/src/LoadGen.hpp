@@ -0,0 +1,93 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** LoadGen
+*/
+
+#pragma once
+
+#include "Bot.hpp"
+#include "Stats.hpp"
+#include <csignal>
+#include <cstdint>
+#include <string>
+#include <sys/socket.h>
+#include <utility>
+#include <vector>
+
+/**
+ * Command-line settings of the load generator.
+ */
+struct LoadConfig {
+    std::string host = "127.0.0.1";
+    int port = 4242;
+    std::vector<std::string> teams;
+    int clients = 100;
+    int seconds = 10;
+    int depth = 1;
+    int rate = 500;
+    int freq = 100;
+    // Behaviour weights, indexed by Command
+    int mix[static_cast<size_t>(Command::COUNT)] = {1, 1, 1, 1};
+};
+
+/**
+ * Single-threaded epoll driver of thousands of simulated AI clients.
+ * Connections are opened at a bounded rate; a client refused a slot, starved
+ * or disconnected is reconnected after a short delay, so the offered load
+ * stays constant for the whole run.
+ */
+class LoadGen {
+    public:
+        /**
+         * Creates the clients, spreading behaviours by the configured mix and
+         * teams round-robin.
+         * @param cfg The settings.
+         */
+        explicit LoadGen(const LoadConfig &cfg);
+
+        /**
+         * Closes every socket.
+         */
+        ~LoadGen();
+
+        LoadGen(const LoadGen &) = delete;
+        LoadGen &operator=(const LoadGen &) = delete;
+
+        /**
+         * Runs the load for the configured time or until stop is set.
+         * @param stop Set by a signal handler to end the run early.
+         * @return False if the server address or epoll could not be set up.
+         */
+        bool run(volatile std::sig_atomic_t &stop);
+
+        /**
+         * Returns what the run measured.
+         */
+        const Stats &stats() const { return _stats; }
+
+        /**
+         * Returns how long the run lasted, in seconds.
+         */
+        double elapsed() const { return _elapsed; }
+
+    private:
+        bool resolve();
+        void connectDue(uint64_t nowUs);
+        bool open(Bot &bot);
+        void close(Bot &bot, uint64_t retryAtUs);
+        void onEvent(Bot &bot, uint32_t events, uint64_t nowUs);
+        bool readLines(Bot &bot, uint64_t nowUs);
+        bool flush(Bot &bot);
+
+        LoadConfig _cfg;
+        std::vector<Bot> _bots;
+        Stats _stats;
+        int _epfd{-1};
+        sockaddr_storage _addr{};
+        socklen_t _addrLen{0};
+        uint64_t _startUs{0};
+        uint64_t _opened{0};
+        double _elapsed{0};
+};
@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Stats
+*/
+
+#include "Stats.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+const CommandInfo COMMANDS[static_cast<size_t>(Command::COUNT)] = {
+    {"Forward", 7},
+    {"Look", 7},
+    {"Broadcast", 7},
+    {"Fork", 42},
+};
+
+static const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+static uint32_t clampUs(uint64_t us) {
+    return static_cast<uint32_t>(std::min<uint64_t>(us,
+        std::numeric_limits<uint32_t>::max()));
+}
+
+void Stats::record(Command cmd, uint64_t latencyUs, uint64_t lateUs) {
+    size_t i = static_cast<size_t>(cmd);
+
+    _latency[i].push_back(clampUs(latencyUs));
+    _late[i].push_back(clampUs(lateUs));
+}
+
+// Nearest-rank quantiles in milliseconds, then the maximum
+static void appendQuantiles(char *buf, size_t size, std::vector<uint32_t> v) {
+    size_t len = 0;
+
+    std::sort(v.begin(), v.end());
+    for (double q : QUANTILES) {
+        size_t rank = v.empty() ? 0 : static_cast<size_t>(q * (v.size() - 1));
+        len += snprintf(buf + len, size - len, " %9.2f",
+            v.empty() ? 0.0 : v[rank] / 1000.0);
+    }
+    snprintf(buf + len, size - len, " %9.2f",
+        v.empty() ? 0.0 : v.back() / 1000.0);
+}
+
+void Stats::report(std::ostream &os, double seconds) const {
+    char line[512];
+    char lat[128];
+    char late[128];
+    uint64_t total = 0;
+
+    os << "# connects " << connects << ", failed " << connectFailures
+       << ", joins " << joins << ", refused " << refused << ", deaths "
+       << deaths << ", dropped " << disconnects << "\n";
+    os << "# bytes in " << bytesIn << ", out " << bytesOut << "\n";
+    os << "# latency and lateness quantiles in milliseconds\n";
+    os << "command      replies    per_s   lat_p50   lat_p90   lat_p99 "
+          "lat_p99.9   lat_max  late_p50  late_p90  late_p99 late_p99.9"
+          "  late_max\n";
+    for (size_t i = 0; i < static_cast<size_t>(Command::COUNT); ++i) {
+        appendQuantiles(lat, sizeof(lat), _latency[i]);
+        appendQuantiles(late, sizeof(late), _late[i]);
+        snprintf(line, sizeof(line), "%-10s %9zu %8.1f%s%s\n",
+            COMMANDS[i].name, _latency[i].size(),
+            seconds > 0 ? _latency[i].size() / seconds : 0.0, lat, late);
+        os << line;
+        total += _latency[i].size();
+    }
+    snprintf(line, sizeof(line), "%-10s %9llu %8.1f\n", "total",
+        static_cast<unsigned long long>(total),
+        seconds > 0 ? total / seconds : 0.0);
+    os << line;
+}
@@ -0,0 +1,71 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Stats
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * Commands the simulated clients repeat; a client's behaviour is one of them.
+ */
+enum class Command {
+    FORWARD,
+    LOOK,
+    BROADCAST,
+    FORK,
+    COUNT
+};
+
+/**
+ * Protocol name and cost in time units of each Command.
+ */
+struct CommandInfo {
+    const char *name;
+    int cost;
+};
+
+extern const CommandInfo COMMANDS[static_cast<size_t>(Command::COUNT)];
+
+/**
+ * Counters and latency samples gathered by the load generator.
+ * Every reply keeps two samples: its latency, from the request being written
+ * to the reply being read, and its lateness, the part of the latency the
+ * command's cost and the client's own earlier commands do not explain.
+ */
+class Stats {
+    public:
+        /**
+         * Records one reply.
+         * @param cmd The command answered.
+         * @param latencyUs Microseconds between request and reply.
+         * @param lateUs Microseconds beyond the command's nominal duration.
+         */
+        void record(Command cmd, uint64_t latencyUs, uint64_t lateUs);
+
+        /**
+         * Writes the summary table.
+         * @param os The stream to write to.
+         * @param seconds The length of the run.
+         */
+        void report(std::ostream &os, double seconds) const;
+
+        uint64_t connects{0};
+        uint64_t connectFailures{0};
+        uint64_t joins{0};
+        uint64_t refused{0};
+        uint64_t deaths{0};
+        uint64_t disconnects{0};
+        uint64_t bytesIn{0};
+        uint64_t bytesOut{0};
+
+    private:
+        std::vector<uint32_t> _latency[static_cast<size_t>(Command::COUNT)];
+        std::vector<uint32_t> _late[static_cast<size_t>(Command::COUNT)];
+};
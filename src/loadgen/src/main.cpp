@@ -0,0 +1,122 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** main - load generator entry point
+*/
+
+#include "LoadGen.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <strings.h>
+
+static volatile std::sig_atomic_t g_stop = 0;
+
+static void onStopSignal(int) {
+    g_stop = 1;
+}
+
+void printUsage(const char *programName) {
+    std::cout << "USAGE: " << programName << " -p port -n team1 [team2 ...] [-h machine] [-c clients]"
+        " [-d seconds] [-q depth] [-r rate] [-f freq] [-m mix]" << std::endl;
+    std::cout << "option description" << std::endl;
+    std::cout << "-p port      port of the game server" << std::endl;
+    std::cout << "-n teams     teams the clients join, round-robin" << std::endl;
+    std::cout << "-h machine   hostname of the game server or unix:/path (default 127.0.0.1)" << std::endl;
+    std::cout << "-c clients   number of simulated clients (default 100)" << std::endl;
+    std::cout << "-d seconds   length of the run (default 10)" << std::endl;
+    std::cout << "-q depth     commands each client keeps in flight, 1 to 10 (default 1)" << std::endl;
+    std::cout << "-r rate      connections opened per second (default 500)" << std::endl;
+    std::cout << "-f freq      the server's frequency, to compute lateness (default 100)" << std::endl;
+    std::cout << "-m mix       behaviour weights, e.g. look=3,broadcast=1,fork=0,forward=2" << std::endl;
+}
+
+bool parseNumber(const char *flag, const char *value, int min, int max, int &out) {
+    try {
+        out = std::stoi(value);
+    } catch (const std::exception &) {
+        out = min - 1;
+    }
+    if (out < min || out > max) {
+        std::cerr << "Error: invalid value for " << flag << ": " << value << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseMix(const std::string &spec, LoadConfig &config) {
+    std::istringstream items(spec);
+    std::string item;
+    int total = 0;
+
+    std::fill(std::begin(config.mix), std::end(config.mix), 0);
+    while (std::getline(items, item, ',')) {
+        size_t eq = item.find('=');
+        size_t c = 0;
+        while (c < static_cast<size_t>(Command::COUNT) &&
+            strcasecmp(item.substr(0, eq).c_str(), COMMANDS[c].name) != 0)
+            ++c;
+        if (eq == std::string::npos || c == static_cast<size_t>(Command::COUNT) ||
+            !parseNumber("-m", item.c_str() + eq + 1, 0, 1000, config.mix[c]))
+            return false;
+        total += config.mix[c];
+    }
+    return total > 0;
+}
+
+bool parseArguments(int argc, char *argv[], LoadConfig &config) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            return false;
+        bool ok = true;
+        if (strcmp(argv[i], "-n") == 0) {
+            while (i + 1 < argc && argv[i + 1][0] != '-')
+                config.teams.emplace_back(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "-p") == 0)
+            ok = parseNumber("-p", argv[i + 1], 1, 65535, config.port);
+        else if (strcmp(argv[i], "-c") == 0)
+            ok = parseNumber("-c", argv[i + 1], 1, 1000000, config.clients);
+        else if (strcmp(argv[i], "-d") == 0)
+            ok = parseNumber("-d", argv[i + 1], 1, 86400, config.seconds);
+        else if (strcmp(argv[i], "-q") == 0)
+            ok = parseNumber("-q", argv[i + 1], 1, 10, config.depth);
+        else if (strcmp(argv[i], "-r") == 0)
+            ok = parseNumber("-r", argv[i + 1], 1, 1000000, config.rate);
+        else if (strcmp(argv[i], "-f") == 0)
+            ok = parseNumber("-f", argv[i + 1], 1, 1000000, config.freq);
+        else if (strcmp(argv[i], "-m") == 0)
+            ok = parseMix(argv[i + 1], config);
+        else if (strcmp(argv[i], "-h") == 0)
+            config.host = argv[i + 1];
+        else
+            return false;
+        if (!ok)
+            return false;
+        i++;
+    }
+    return !config.teams.empty();
+}
+
+int main(int argc, char *argv[]) {
+    LoadConfig config;
+
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    LoadGen gen(config);
+    if (!gen.run(g_stop))
+        return 1;
+    std::cout << "# zappy_loadgen: " << config.clients << " clients, depth "
+        << config.depth << ", " << gen.elapsed() << " s" << std::endl;
+    gen.stats().report(std::cout, gen.elapsed());
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** FanoutWorker
+*/
+
+#include "FanoutWorker.hpp"
+#include "Relay.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+FanoutWorker::FanoutWorker(Relay &relay) : _relay(relay) {}
+
+FanoutWorker::~FanoutWorker() {
+    if (_running.exchange(false)) {
+        wake();
+        _thread.join();
+    }
+    for (auto &client : _clients)
+        close(client.fd);
+    for (int fd : _newFds)
+        close(fd);
+    for (int fd : _wake)
+        if (fd != -1)
+            close(fd);
+}
+
+bool FanoutWorker::start() {
+    if (pipe(_wake) == -1)
+        return false;
+    fcntl(_wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(_wake[1], F_SETFL, O_NONBLOCK);
+    _running = true;
+    _thread = std::thread(&FanoutWorker::run, this);
+    return true;
+}
+
+void FanoutWorker::wake() {
+    char byte = 1;
+
+    (void)!write(_wake[1], &byte, 1);
+}
+
+void FanoutWorker::addClient(int fd) {
+    {
+        std::lock_guard<std::mutex> lock(_inboxMutex);
+        _newFds.push_back(fd);
+    }
+    _count.fetch_add(1, std::memory_order_relaxed);
+    wake();
+}
+
+void FanoutWorker::publish(uint64_t version, Chunk chunk) {
+    {
+        std::lock_guard<std::mutex> lock(_inboxMutex);
+        _chunks.emplace_back(version, std::move(chunk));
+    }
+    wake();
+}
+
+void FanoutWorker::takeInbox() {
+    std::vector<int> fds;
+    std::vector<std::pair<uint64_t, Chunk>> chunks;
+    char drain[64];
+
+    while (read(_wake[0], drain, sizeof(drain)) > 0) {}
+    {
+        std::lock_guard<std::mutex> lock(_inboxMutex);
+        fds.swap(_newFds);
+        chunks.swap(_chunks);
+    }
+    for (const auto &[version, chunk] : chunks)
+        for (auto &client : _clients)
+            if (client.graphic && version > client.since)
+                client.out += *chunk;
+    for (int fd : fds) {
+        _clients.push_back(Client{fd, {}, "WELCOME\n"});
+    }
+}
+
+void FanoutWorker::handleLine(Client &client, const std::string &line) {
+    if (!client.graphic) {
+        if (line != "GRAPHIC") {
+            client.out += "ko\n";
+            client.dead = true;
+            return;
+        }
+        client.out += _relay.snapshot(client.since);
+        client.graphic = true;
+        return;
+    }
+    if (Snapshot::mustForward(line))
+        _relay.forwardUpstream(line + "\n");
+    else
+        client.out += _relay.answer(line);
+}
+
+void FanoutWorker::handleRead(Client &client) {
+    char buf[1024];
+    ssize_t n = recv(client.fd, buf, sizeof(buf), 0);
+    size_t pos;
+
+    if (n <= 0) {
+        client.dead = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        return;
+    }
+    client.in.append(buf, static_cast<size_t>(n));
+    while ((pos = client.in.find('\n')) != std::string::npos && !client.dead) {
+        std::string line = client.in.substr(0, pos);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        client.in.erase(0, pos + 1);
+        handleLine(client, line);
+    }
+}
+
+void FanoutWorker::flush(Client &client) {
+    while (client.outOff < client.out.size()) {
+        ssize_t n = send(client.fd, client.out.data() + client.outOff,
+            client.out.size() - client.outOff, MSG_NOSIGNAL);
+        if (n < 0) {
+            client.dead = errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR;
+            break;
+        }
+        client.outOff += static_cast<size_t>(n);
+    }
+    if (client.outOff == client.out.size()) {
+        client.out.clear();
+        client.outOff = 0;
+    } else if (client.out.size() - client.outOff > BACKLOG_MAX) {
+        client.dead = true;
+    }
+}
+
+void FanoutWorker::reap() {
+    auto it = std::remove_if(_clients.begin(), _clients.end(), [](const Client &c) {
+        if (c.dead)
+            close(c.fd);
+        return c.dead;
+    });
+    _count.fetch_sub(static_cast<size_t>(_clients.end() - it), std::memory_order_relaxed);
+    _clients.erase(it, _clients.end());
+}
+
+void FanoutWorker::run() {
+    std::vector<pollfd> pfds;
+
+    while (_running.load()) {
+        pfds.assign(1, pollfd{_wake[0], POLLIN, 0});
+        for (const auto &client : _clients)
+            pfds.push_back(pollfd{client.fd,
+                static_cast<short>(POLLIN | (client.out.empty() ? 0 : POLLOUT)), 0});
+        if (::poll(pfds.data(), pfds.size(), 200) < 0 && errno != EINTR)
+            break;
+        for (size_t i = 1; i < pfds.size(); ++i)
+            if (pfds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                handleRead(_clients[i - 1]);
+        takeInbox();
+        for (auto &client : _clients)
+            if (!client.out.empty())
+                flush(client);
+        reap();
+    }
+}
@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** FanoutWorker
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Relay;
+
+/**
+ * Owns a shard of downstream GUI connections and writes the upstream deltas
+ * to them on its own thread, so a slow viewer never stalls the relay loop.
+ */
+class FanoutWorker {
+    public:
+        using Chunk = std::shared_ptr<const std::string>;
+
+        /**
+         * Maximum bytes queued for one viewer before it is disconnected.
+         */
+        static constexpr size_t BACKLOG_MAX = 4 * 1024 * 1024;
+
+        /**
+         * Creates a worker bound to the relay that answers snapshots and queries.
+         * @param relay The relay owning the mirrored world model.
+         */
+        explicit FanoutWorker(Relay &relay);
+
+        /**
+         * Stops the thread and closes every connection it owns.
+         */
+        ~FanoutWorker();
+
+        /**
+         * Starts the worker thread.
+         * @return True if the wake-up pipe could be created.
+         */
+        bool start();
+
+        /**
+         * Hands a freshly accepted connection over to this worker.
+         * @param fd The downstream socket.
+         */
+        void addClient(int fd);
+
+        /**
+         * Queues a batch of upstream lines for every viewer of this shard.
+         * @param version The model version reached once the batch is applied.
+         * @param chunk The raw protocol lines of the batch.
+         */
+        void publish(uint64_t version, Chunk chunk);
+
+        /**
+         * Returns the number of connections owned by this worker.
+         * @return The connection count.
+         */
+        size_t clientCount() const { return _count.load(std::memory_order_relaxed); }
+
+    private:
+        struct Client {
+            int fd;
+            std::string in;
+            std::string out;
+            size_t outOff{0};
+            bool graphic{false};
+            bool dead{false};
+            uint64_t since{0};
+        };
+
+        void run();
+        void wake();
+        void takeInbox();
+        void handleRead(Client &client);
+        void handleLine(Client &client, const std::string &line);
+        void flush(Client &client);
+        void reap();
+
+        Relay &_relay;
+        std::thread _thread;
+        std::atomic<bool> _running{false};
+        std::atomic<size_t> _count{0};
+        int _wake[2]{-1, -1};
+
+        std::mutex _inboxMutex;
+        std::vector<int> _newFds;
+        std::vector<std::pair<uint64_t, Chunk>> _chunks;
+
+        std::vector<Client> _clients;
+};
@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Relay
+*/
+
+#include "Relay.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+Relay::Relay(const std::string &host, uint16_t upstreamPort, uint16_t listenPort, size_t threads)
+    : _model(host, upstreamPort), _listenPort(listenPort) {
+    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+        _workers.push_back(std::make_unique<FanoutWorker>(*this));
+}
+
+Relay::~Relay() {
+    _workers.clear();
+    if (_listenFd != -1)
+        close(_listenFd);
+}
+
+bool Relay::listen() {
+    int opt = 1;
+    sockaddr_in addr{};
+
+    _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_listenFd == -1)
+        return false;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(_listenPort);
+    if (bind(_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == -1 ||
+        ::listen(_listenFd, SOMAXCONN) == -1) {
+        perror("relay listen");
+        return false;
+    }
+    fcntl(_listenFd, F_SETFL, fcntl(_listenFd, F_GETFL, 0) | O_NONBLOCK);
+    return true;
+}
+
+bool Relay::start() {
+    _model.setLineObserver([this](const std::string &line) {
+        if (line != "WELCOME")
+            _batch += line + "\n";
+    });
+    if (!_model.connect() || !listen())
+        return false;
+    for (auto &worker : _workers)
+        if (!worker->start())
+            return false;
+    return true;
+}
+
+void Relay::acceptClients() {
+    int fd;
+
+    while ((fd = accept(_listenFd, nullptr, nullptr)) != -1) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        auto least = std::min_element(_workers.begin(), _workers.end(),
+            [](const auto &a, const auto &b) { return a->clientCount() < b->clientCount(); });
+        (*least)->addClient(fd);
+    }
+}
+
+void Relay::pumpUpstream() {
+    FanoutWorker::Chunk chunk;
+    uint64_t version;
+
+    {
+        std::unique_lock<std::shared_mutex> lock(_modelMutex);
+        _model.poll();
+        if (_batch.empty())
+            return;
+        chunk = std::make_shared<const std::string>(std::move(_batch));
+        _batch.clear();
+        version = ++_version;
+    }
+    for (auto &worker : _workers)
+        worker->publish(version, chunk);
+}
+
+void Relay::flushUpstream() {
+    std::string out;
+
+    {
+        std::lock_guard<std::mutex> lock(_upstreamMutex);
+        out.swap(_upstreamOut);
+    }
+    if (!out.empty())
+        _model.sendRaw(out);
+    else if (_model.hasPendingWrites())
+        _model.flushWrites();
+}
+
+void Relay::run() {
+    pollfd fds[2];
+
+    while (_model.isConnected()) {
+        fds[0] = pollfd{_model.getSocket(),
+            static_cast<short>(POLLIN | (_model.hasPendingWrites() ? POLLOUT : 0)), 0};
+        fds[1] = pollfd{_listenFd, POLLIN, 0};
+        if (::poll(fds, 2, fds[0].fd == -1 ? 10 : 50) < 0)
+            continue;
+        if (fds[1].revents & POLLIN)
+            acceptClients();
+        // A shared-memory upstream has no descriptor: pump it on every tick
+        if (fds[0].fd == -1 || (fds[0].revents & (POLLIN | POLLHUP | POLLERR)))
+            pumpUpstream();
+        flushUpstream();
+    }
+    std::cerr << "relay: upstream connection closed" << std::endl;
+}
+
+std::string Relay::snapshot(uint64_t &version) {
+    std::shared_lock<std::shared_mutex> lock(_modelMutex);
+
+    version = _version;
+    return Snapshot::build(_model);
+}
+
+std::string Relay::answer(const std::string &query) {
+    std::shared_lock<std::shared_mutex> lock(_modelMutex);
+
+    return Snapshot::answer(_model, query);
+}
+
+void Relay::forwardUpstream(const std::string &line) {
+    std::lock_guard<std::mutex> lock(_upstreamMutex);
+
+    _upstreamOut += line;
+}
@@ -0,0 +1,90 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Relay
+*/
+
+#pragma once
+
+#include "FanoutWorker.hpp"
+#include "ServerUpdateManager.hpp"
+#include "Snapshot.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Spectator relay: holds one GRAPHIC connection to zappy_server, mirrors the
+ * world in a ServerUpdateManager and serves any number of downstream GUIs.
+ * Snapshots and queries are answered from the mirror; deltas are fanned out
+ * by a pool of FanoutWorker threads.
+ */
+class Relay {
+    public:
+        /**
+         * Creates the relay.
+         * @param host The hostname or IP address of the game server.
+         * @param upstreamPort The port of the game server.
+         * @param listenPort The port downstream GUIs connect to.
+         * @param threads The number of fan-out threads.
+         */
+        Relay(const std::string &host, uint16_t upstreamPort, uint16_t listenPort, size_t threads);
+
+        /**
+         * Stops the workers and closes every socket.
+         */
+        ~Relay();
+
+        /**
+         * Connects upstream, opens the listening socket and starts the workers.
+         * @return True when the relay is ready to serve.
+         */
+        bool start();
+
+        /**
+         * Runs the relay loop until the game server closes the connection.
+         */
+        void run();
+
+        /**
+         * Serializes the mirrored world for a new viewer.
+         * @param version Receives the model version the snapshot reflects.
+         * @return The snapshot stream.
+         */
+        std::string snapshot(uint64_t &version);
+
+        /**
+         * Answers a GUI query from the mirrored world.
+         * @param query The query line, without its trailing newline.
+         * @return The reply lines.
+         */
+        std::string answer(const std::string &query);
+
+        /**
+         * Queues a line to be sent to the game server by the relay loop.
+         * @param line The line, including its trailing newline.
+         */
+        void forwardUpstream(const std::string &line);
+
+    private:
+        bool listen();
+        void acceptClients();
+        void pumpUpstream();
+        void flushUpstream();
+
+        ServerUpdateManager _model;
+        std::shared_mutex _modelMutex;
+        uint64_t _version{0};
+        std::string _batch;
+
+        std::mutex _upstreamMutex;
+        std::string _upstreamOut;
+
+        uint16_t _listenPort;
+        int _listenFd{-1};
+        std::vector<std::unique_ptr<FanoutWorker>> _workers;
+};
@@ -0,0 +1,139 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Snapshot
+*/
+
+#include "Snapshot.hpp"
+#include <cstdio>
+
+namespace {
+    std::string bct(const ServerUpdateManager &model, int x, int y) {
+        const ServerUpdateManager::Resources *r = model.getTileResources(x, y);
+        char line[128];
+
+        if (!r)
+            return "sbp\n";
+        snprintf(line, sizeof(line), "bct %d %d %d %d %d %d %d %d %d\n", x, y,
+            r->qty[0], r->qty[1], r->qty[2], r->qty[3], r->qty[4], r->qty[5], r->qty[6]);
+        return line;
+    }
+
+    std::string pnw(const ServerUpdateManager::Player &p) {
+        char line[384];
+
+        snprintf(line, sizeof(line), "pnw #%d %d %d %d %d %s\n",
+            p.id, p.x, p.y, p.orientation, p.level, p.team.c_str());
+        return line;
+    }
+
+    std::string ppo(const ServerUpdateManager::Player &p) {
+        char line[96];
+
+        snprintf(line, sizeof(line), "ppo #%d %d %d %d\n", p.id, p.x, p.y, p.orientation);
+        return line;
+    }
+
+    std::string plv(const ServerUpdateManager::Player &p) {
+        char line[64];
+
+        snprintf(line, sizeof(line), "plv #%d %d\n", p.id, p.level);
+        return line;
+    }
+
+    std::string pin(const ServerUpdateManager::Player &p) {
+        const int *q = p.inv.qty;
+        char line[160];
+
+        snprintf(line, sizeof(line), "pin #%d %d %d %d %d %d %d %d %d %d\n",
+            p.id, p.x, p.y, q[0], q[1], q[2], q[3], q[4], q[5], q[6]);
+        return line;
+    }
+
+    std::string enw(const ServerUpdateManager::Egg &e) {
+        char line[96];
+
+        snprintf(line, sizeof(line), "enw #%d #%d %d %d\n", e.id, e.playerId, e.x, e.y);
+        return line;
+    }
+
+    std::string mct(const ServerUpdateManager &model) {
+        std::string out;
+
+        for (int y = 0; y < model.getBoardHeight(); ++y)
+            for (int x = 0; x < model.getBoardWidth(); ++x)
+                out += bct(model, x, y);
+        return out;
+    }
+
+    std::string tna(const ServerUpdateManager &model) {
+        std::string out;
+
+        for (const auto &name : model.getTeamNames())
+            out += "tna " + name + "\n";
+        return out;
+    }
+
+    std::string sgt(const ServerUpdateManager &model) {
+        return "sgt " + std::to_string(model.getTimeUnit()) + "\n";
+    }
+
+    std::string playerQuery(const ServerUpdateManager &model, const std::string &query) {
+        char cmd[4] = {0};
+        int id = 0;
+
+        if (sscanf(query.c_str(), "%3s #%d", cmd, &id) != 2)
+            return "sbp\n";
+        const ServerUpdateManager::Player *p = model.getPlayer(id);
+        if (!p)
+            return "sbp\n";
+        std::string name(cmd);
+        if (name == "ppo")
+            return ppo(*p);
+        if (name == "plv")
+            return plv(*p);
+        return pin(*p);
+    }
+}
+
+std::string Snapshot::build(const ServerUpdateManager &model) {
+    std::string out = "msz " + std::to_string(model.getBoardWidth()) + " " +
+        std::to_string(model.getBoardHeight()) + "\n";
+
+    out += mct(model);
+    out += tna(model);
+    for (const auto &[id, player] : model.getPlayers()) {
+        out += pnw(player);
+        out += pin(player);
+    }
+    for (const auto &[id, egg] : model.getEggs())
+        if (egg.alive)
+            out += enw(egg);
+    out += sgt(model);
+    return out;
+}
+
+std::string Snapshot::answer(const ServerUpdateManager &model, const std::string &query) {
+    int x = 0;
+    int y = 0;
+
+    if (query == "msz")
+        return "msz " + std::to_string(model.getBoardWidth()) + " " +
+            std::to_string(model.getBoardHeight()) + "\n";
+    if (query == "mct")
+        return mct(model);
+    if (query == "tna")
+        return tna(model);
+    if (query == "sgt")
+        return sgt(model);
+    if (query.rfind("bct", 0) == 0)
+        return sscanf(query.c_str(), "bct %d %d", &x, &y) == 2 ? bct(model, x, y) : "sbp\n";
+    if (query.rfind("ppo", 0) == 0 || query.rfind("plv", 0) == 0 || query.rfind("pin", 0) == 0)
+        return playerQuery(model, query);
+    return "suc\n";
+}
+
+bool Snapshot::mustForward(const std::string &query) {
+    return query.rfind("sst", 0) == 0;
+}
@@ -0,0 +1,35 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** Snapshot
+*/
+
+#pragma once
+
+#include "ServerUpdateManager.hpp"
+#include <string>
+
+namespace Snapshot {
+    /**
+     * @brief Serializes the whole model as the stream a GUI expects on login.
+     * @param model The world state mirrored from the server.
+     * @return msz, bct for every tile, tna, pnw/pin per player, enw per egg and sgt.
+     */
+    std::string build(const ServerUpdateManager &model);
+
+    /**
+     * @brief Answers a GUI query from the mirrored model.
+     * @param model The world state mirrored from the server.
+     * @param query The query line, without its trailing newline.
+     * @return The reply lines, "sbp" on bad parameters or "suc" for unknown commands.
+     */
+    std::string answer(const ServerUpdateManager &model, const std::string &query);
+
+    /**
+     * @brief Tells whether a GUI command changes server state and must be forwarded.
+     * @param query The query line, without its trailing newline.
+     * @return True for commands the relay cannot answer by itself (sst).
+     */
+    bool mustForward(const std::string &query);
+}
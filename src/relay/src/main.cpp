@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** main - spectator relay entry point
+*/
+
+#include "Relay.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+struct RelayConfig {
+    int port = 4343;
+    int upstreamPort = 4242;
+    std::string hostname = "127.0.0.1";
+    size_t threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+};
+
+void printUsage(const char *programName) {
+    std::cout << "USAGE: " << programName << " -p port -h machine -u upstream_port [-t threads]" << std::endl;
+    std::cout << "option description" << std::endl;
+    std::cout << "-p port           port the GUIs connect to" << std::endl;
+    std::cout << "-h machine        hostname of the game server, unix:/path or shm:name" << std::endl;
+    std::cout << "-u upstream_port  port of the game server" << std::endl;
+    std::cout << "-t threads        number of fan-out threads" << std::endl;
+}
+
+bool parseNumber(const char *flag, const char *value, int min, int max, int &out) {
+    try {
+        out = std::stoi(value);
+    } catch (const std::exception &) {
+        out = min - 1;
+    }
+    if (out < min || out > max) {
+        std::cerr << "Error: invalid value for " << flag << ": " << value << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseArguments(int argc, char *argv[], RelayConfig &config) {
+    int threads = static_cast<int>(config.threads);
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+        bool ok = true;
+        if (strcmp(argv[i], "-p") == 0)
+            ok = parseNumber("-p", argv[i + 1], 1, 65535, config.port);
+        else if (strcmp(argv[i], "-u") == 0)
+            ok = parseNumber("-u", argv[i + 1], 1, 65535, config.upstreamPort);
+        else if (strcmp(argv[i], "-t") == 0)
+            ok = parseNumber("-t", argv[i + 1], 1, 256, threads);
+        else if (strcmp(argv[i], "-h") == 0)
+            config.hostname = argv[i + 1];
+        else {
+            printUsage(argv[0]);
+            return false;
+        }
+        if (!ok)
+            return false;
+        i++;
+    }
+    config.threads = static_cast<size_t>(threads);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    RelayConfig config;
+
+    if (!parseArguments(argc, argv, config))
+        return 1;
+    std::signal(SIGPIPE, SIG_IGN);
+    Relay relay(config.hostname, static_cast<uint16_t>(config.upstreamPort),
+        static_cast<uint16_t>(config.port), config.threads);
+    if (!relay.start()) {
+        std::cerr << "relay: cannot start" << std::endl;
+        return 1;
+    }
+    relay.run();
+    return 0;
+}
@@ -0,0 +1,219 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench - micro-benchmarks of the server hot paths, as JSON
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Command-line settings of the benchmark run.
+ * @param out Where the JSON report goes, stdout if NULL.
+ * @param filter Only the cases whose name contains it, all if NULL.
+ * @param samples The number of timed samples per value.
+ * @param sample_ms The minimum length of a sample.
+ */
+typedef struct s_bench_opts {
+    const char *out;
+    const char *filter;
+    int samples;
+    int sample_ms;
+} bench_opts_t;
+
+/**
+ * @brief What a case measured at one value, in nanoseconds per operation.
+ */
+typedef struct s_bench_result {
+    uint64_t iters;
+    double median;
+    double min;
+    double max;
+} bench_result_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static double time_run(const bench_case_t *c, bench_fix_t *f,
+    uint64_t iters, uint64_t *ops)
+{
+    uint64_t start = now_ns();
+
+    *ops = c->run(f, iters);
+    return (double)(now_ns() - start);
+}
+
+/* Doubles the iteration count until one sample lasts sample_ms */
+static uint64_t calibrate(const bench_case_t *c, bench_fix_t *f,
+    const bench_opts_t *o)
+{
+    double target = (double)o->sample_ms * 1e6;
+    uint64_t iters = 1;
+    uint64_t ops;
+
+    while (time_run(c, f, iters, &ops) < target)
+        iters *= 2;
+    return iters;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void measure(const bench_case_t *c, bench_fix_t *f,
+    const bench_opts_t *o, bench_result_t *r)
+{
+    double ns[BENCH_MAX_SAMPLES];
+    uint64_t ops = 0;
+    double t;
+
+    r->iters = calibrate(c, f, o);
+    for (int s = 0; s < o->samples; ++s) {
+        t = time_run(c, f, r->iters, &ops);
+        ns[s] = ops ? t / (double)ops : 0.0;
+    }
+    qsort(ns, (size_t)o->samples, sizeof(ns[0]), cmp_double);
+    r->median = ns[o->samples / 2];
+    r->min = ns[0];
+    r->max = ns[o->samples - 1];
+}
+
+static void print_result(FILE *out, const bench_case_t *c, long value,
+    const bench_result_t *r, bool first)
+{
+    fprintf(out, "%s    {\"name\": \"%s\", \"param\": \"%s\", "
+        "\"value\": %ld, \"unit\": \"%s\", \"iters\": %llu, "
+        "\"ns_per_op\": {\"median\": %.3f, \"min\": %.3f, \"max\": %.3f}, "
+        "\"ops_per_s\": %.1f}", first ? "" : ",\n", c->name, c->param,
+        value, c->unit, (unsigned long long)r->iters, r->median, r->min,
+        r->max, r->median > 0 ? 1e9 / r->median : 0.0);
+    fprintf(stderr, "%-24s %-9s %6ld %12.1f ns/%s\n", c->name, c->param,
+        value, r->median, c->unit);
+}
+
+/* Each value gets a fresh fixture, so cases never see each other's state */
+static bool bench_value(FILE *out, const bench_case_t *c, long value,
+    const bench_opts_t *o, bool *first)
+{
+    bench_fix_t *f = calloc(1, sizeof(*f));
+    bench_result_t r;
+    bool ok;
+
+    if (!f)
+        return false;
+    f->value = value;
+    ok = c->setup(f);
+    if (ok) {
+        measure(c, f, o, &r);
+        print_result(out, c, value, &r, *first);
+        *first = false;
+    }
+    bench_fix_free(f);
+    free(f);
+    return ok;
+}
+
+static bool bench_group(FILE *out, const bench_case_t *cases, size_t n,
+    const bench_opts_t *o, bool *first)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (o->filter && !strstr(cases[i].name, o->filter))
+            continue;
+        for (int v = 0; v < BENCH_MAX_VALUES && cases[i].values[v]; ++v)
+            if (!bench_value(out, &cases[i], cases[i].values[v], o, first))
+                return false;
+    }
+    return true;
+}
+
+static bool bench_all(FILE *out, const bench_opts_t *o)
+{
+    const bench_case_t *(*const groups[])(size_t *) = {
+        bench_sched_cases, bench_world_cases, bench_net_cases,
+        bench_journal_cases,
+    };
+    const bench_case_t *cases;
+    bool first = true;
+    size_t n;
+
+    fprintf(out, "{\n  \"suite\": \"zappy_server\",\n  \"schema\": %d,\n"
+        "  \"seed\": %d,\n  \"samples\": %d,\n  \"sample_ms\": %d,\n"
+        "  \"results\": [\n", BENCH_SCHEMA, BENCH_SEED, o->samples,
+        o->sample_ms);
+    for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); ++g) {
+        cases = groups[g](&n);
+        if (!bench_group(out, cases, n, o, &first))
+            return false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+    return true;
+}
+
+static bool parse_count(const char *str, int max, int *out)
+{
+    char *end = NULL;
+    long v = str ? strtol(str, &end, 10) : 0;
+
+    if (!end || *end || v < 1 || v > max)
+        return false;
+    *out = (int)v;
+    return true;
+}
+
+static bool parse_opts(int ac, char **av, bench_opts_t *o)
+{
+    for (int i = 1; i < ac; i += 2) {
+        if (!strcmp(av[i], "-o") && av[i + 1])
+            o->out = av[i + 1];
+        if (!strcmp(av[i], "-f") && av[i + 1])
+            o->filter = av[i + 1];
+        if ((!strcmp(av[i], "-o") || !strcmp(av[i], "-f")) && av[i + 1])
+            continue;
+        if (!strcmp(av[i], "-s") &&
+            parse_count(av[i + 1], BENCH_MAX_SAMPLES, &o->samples))
+            continue;
+        if (!strcmp(av[i], "-t") &&
+            parse_count(av[i + 1], 60000, &o->sample_ms))
+            continue;
+        return false;
+    }
+    return true;
+}
+
+int main(int ac, char **av)
+{
+    bench_opts_t o = {.out = NULL, .filter = NULL, .samples = 5,
+        .sample_ms = 100};
+    FILE *out;
+    bool ok;
+
+    if (!parse_opts(ac, av, &o)) {
+        fprintf(stderr, "USAGE: %s [-o file.json] [-f name] [-s samples] "
+            "[-t sample_ms]\n", av[0]);
+        return EXIT_FAILURE;
+    }
+    out = o.out ? fopen(o.out, "w") : stdout;
+    if (!out) {
+        perror(o.out);
+        return EXIT_FAILURE;
+    }
+    ok = bench_all(out, &o);
+    if (out != stdout)
+        fclose(out);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "net_poll.h"
+#include "scheduler.h"
+#include "world.h"
+
+#ifndef BENCH_H
+    #define BENCH_H
+    #define BENCH_SCHEMA 1
+    #define BENCH_SEED 42
+    #define BENCH_FREQ 100
+    #define BENCH_MAX_VALUES 8
+    #define BENCH_MAX_SAMPLES 64
+    #define BENCH_FEED_BYTES 4096
+    #define BENCH_JOURNAL "/dev/null"
+
+/**
+ * @brief Everything a benchmark case works on, rebuilt for every value.
+ * @param world The map, created with the fixed BENCH_SEED.
+ * @param net The network state, without any socket.
+ * @param sched The scheduler under test, or the one commands go to.
+ * @param snapshot A filled heap that sched is restored from.
+ * @param times The exec_at of each pushed action, drawn once.
+ * @param pl The player the case drives.
+ * @param gui The GUI client receiving the map, or NULL.
+ * @param out The reply buffer of Look.
+ * @param feed The bytes fed to player_feed.
+ * @param value The value of the case's parameter.
+ */
+typedef struct s_bench_fix {
+    world_t world;
+    net_t *net;
+    scheduler_t sched;
+    scheduler_t snapshot;
+    uint64_t times[SCHED_MAX];
+    player_t *pl;
+    player_t *gui;
+    outbuf_t out;
+    char feed[BENCH_FEED_BYTES];
+    long value;
+} bench_fix_t;
+
+/**
+ * @brief One benchmarked operation, measured at each of its values.
+ * @param name The function under test.
+ * @param param What the values stand for, e.g. "heap".
+ * @param unit What one operation is, e.g. "push".
+ * @param values The parameter values, 0-terminated.
+ * @param setup Builds the fixture for one value, false on failure.
+ * @param run Performs iters iterations, returns the operations done.
+ */
+typedef struct s_bench_case {
+    const char *name;
+    const char *param;
+    const char *unit;
+    long values[BENCH_MAX_VALUES];
+    bool (*setup)(bench_fix_t *f);
+    uint64_t (*run)(bench_fix_t *f, uint64_t iters);
+} bench_case_t;
+
+/**
+ * @brief Creates a square world and an empty, socket-less network.
+ * @param f The fixture, zeroed.
+ * @param side The width and height of the map.
+ * @return False if an allocation failed.
+ */
+bool bench_fix_world(bench_fix_t *f, int side);
+/**
+ * @brief Connects a player on the fixture's network.
+ * @param f The fixture, with its world created.
+ * @param team_idx The team, or -2 for a GUI client.
+ * @return The player at a random position, or NULL if the pool is empty.
+ */
+player_t *bench_fix_player(bench_fix_t *f, int team_idx);
+/**
+ * @brief Releases everything the fixture holds and zeroes it.
+ * @param f The fixture.
+ */
+void bench_fix_free(bench_fix_t *f);
+/**
+ * @brief Empties the output queue of every connected client.
+ * @param net The fixture's network.
+ */
+void bench_fix_drain(net_t *net);
+
+/**
+ * @brief The scheduler cases.
+ * @param count Receives the number of cases.
+ * @return The cases.
+ */
+const bench_case_t *bench_sched_cases(size_t *count);
+/**
+ * @brief The Look, refill and GUI map cases.
+ * @param count Receives the number of cases.
+ * @return The cases.
+ */
+const bench_case_t *bench_world_cases(size_t *count);
+/**
+ * @brief The broadcast and input framing cases.
+ * @param count Receives the number of cases.
+ * @return The cases.
+ */
+const bench_case_t *bench_net_cases(size_t *count);
+/**
+ * @brief The match journal cases.
+ * @param count Receives the number of cases.
+ * @return The cases.
+ */
+const bench_case_t *bench_journal_cases(size_t *count);
+
+#endif /* BENCH_H */
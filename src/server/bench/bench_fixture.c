@@ -0,0 +1,72 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench_fixture
+*/
+
+#include "bench.h"
+#include "journal.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool bench_fix_world(bench_fix_t *f, int side)
+{
+    cfg_t cfg = {.width = side, .height = side, .freq = BENCH_FREQ,
+        .seed = BENCH_SEED, .seeded = true};
+
+    if (!world_create(&f->world, &cfg))
+        return false;
+    f->net = calloc(1, sizeof(*f->net));
+    if (!f->net || !player_pool_init(&f->net->pool, NET_MAX_FDS))
+        return false;
+    scheduler_init(&f->sched);
+    ritual_pool_init(&f->net->rituals);
+    f->net->world = &f->world;
+    f->net->sched = &f->sched;
+    f->net->freq = BENCH_FREQ;
+    return true;
+}
+
+player_t *bench_fix_player(bench_fix_t *f, int team_idx)
+{
+    net_t *net = f->net;
+    player_t *p;
+
+    if (net->nfds >= NET_MAX_FDS)
+        return NULL;
+    p = player_create(&net->pool, -1, net);
+    if (!p)
+        return NULL;
+    p->authed = true;
+    p->team_idx = team_idx;
+    if (team_idx >= 0)
+        player_place(p);
+    net->players[net->nfds++] = p;
+    return p;
+}
+
+void bench_fix_drain(net_t *net)
+{
+    for (int i = net->nlisten; i < net->nfds; ++i)
+        outbuf_drop_pending(&((player_t *)net->players[i])->out);
+    arena_reset(&net->tick);
+}
+
+void bench_fix_free(bench_fix_t *f)
+{
+    if (f->net) {
+        for (int i = 0; i < f->net->nfds; ++i)
+            player_destroy(&f->net->pool, f->net->players[i]);
+        player_pool_destroy(&f->net->pool);
+        arena_destroy(&f->net->tick);
+        free(f->net);
+    }
+    journal_close(f->world.journal);
+    if (f->world.chunks)
+        world_destroy(&f->world);
+    outbuf_free(&f->out);
+    scheduler_destroy(&f->sched);
+    scheduler_destroy(&f->snapshot);
+    memset(f, 0, sizeof(*f));
+}
@@ -0,0 +1,71 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench_journal
+*/
+
+#include "bench.h"
+#include "journal.h"
+
+static const int JOURNAL_SIDE = 30;
+static const int KEYFRAME_PLAYERS = 64;
+
+/* /dev/null keeps the write syscalls but not the disk: see the README */
+static bool setup_journal(bench_fix_t *f, int side)
+{
+    if (!bench_fix_world(f, side))
+        return false;
+    f->pl = bench_fix_player(f, 0);
+    if (!f->pl)
+        return false;
+    f->world.journal = journal_open(BENCH_JOURNAL, f->net);
+    return f->world.journal != NULL;
+}
+
+static bool setup_event(bench_fix_t *f)
+{
+    return setup_journal(f, JOURNAL_SIDE);
+}
+
+/* One record of value fields, with its share of the 64 KiB flushes */
+static uint64_t run_event(bench_fix_t *f, uint64_t iters)
+{
+    uint64_t fields[13] = {f->pl->id, 12, 7, 3, 1, 0, 9, 1, 0, 2, 0, 0, 1};
+    size_t n = (size_t)f->value;
+
+    for (uint64_t it = 0; it < iters; ++it)
+        journal_event(f->world.journal, J_MOVE, fields, n);
+    return iters;
+}
+
+static bool setup_keyframe(bench_fix_t *f)
+{
+    if (!setup_journal(f, (int)f->value))
+        return false;
+    for (int i = 1; i < KEYFRAME_PLAYERS; ++i)
+        if (!bench_fix_player(f, 0))
+            return false;
+    return true;
+}
+
+/* A full snapshot and the two flushes around it */
+static uint64_t run_keyframe(bench_fix_t *f, uint64_t iters)
+{
+    for (uint64_t it = 0; it < iters; ++it)
+        journal_keyframe(f->world.journal, f->net);
+    return iters;
+}
+
+static const bench_case_t CASES[] = {
+    {"journal_event", "fields", "record", {1, 4, 13, 0},
+        setup_event, run_event},
+    {"journal_keyframe", "side", "keyframe", {10, 50, 100, 0},
+        setup_keyframe, run_keyframe},
+};
+
+const bench_case_t *bench_journal_cases(size_t *count)
+{
+    *count = sizeof(CASES) / sizeof(CASES[0]);
+    return CASES;
+}
@@ -0,0 +1,104 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench_net
+*/
+
+#include "bench.h"
+#include "command_broadcast.h"
+#include <string.h>
+
+static const int BROADCAST_SIDE = 50;
+static char BROADCAST_TEXT[] = "the quick brown fox jumps over the lazy dog";
+static const char BROADCAST_CMD[] =
+    "Broadcast the quick brown fox jumps over the lazy dog";
+static const char FEED_LINE[] = "Forward\n";
+static const size_t FEED_LINE_LEN = sizeof(FEED_LINE) - 1;
+
+static bool setup_broadcast(bench_fix_t *f)
+{
+    if (!bench_fix_world(f, BROADCAST_SIDE))
+        return false;
+    for (long i = 0; i < f->value; ++i)
+        if (!bench_fix_player(f, 0))
+            return false;
+    f->pl = f->net->players[0];
+    return true;
+}
+
+/* One broadcast heard by every player, the emitter included */
+static uint64_t run_broadcast(bench_fix_t *f, uint64_t iters)
+{
+    broadcast_ctx_t ctx = {.pl = f->pl, .owner = f->pl->id,
+        .msg = BROADCAST_TEXT};
+
+    for (uint64_t it = 0; it < iters; ++it) {
+        broadcast_to_players(&ctx);
+        bench_fix_drain(f->net);
+    }
+    return iters;
+}
+
+static bool setup_broadcast_cmd(bench_fix_t *f)
+{
+    if (!bench_fix_world(f, BROADCAST_SIDE))
+        return false;
+    f->pl = bench_fix_player(f, 0);
+    return f->pl != NULL;
+}
+
+/* value broadcasts queued, then fired: context, text and line allocation */
+static uint64_t run_broadcast_cmd(bench_fix_t *f, uint64_t iters)
+{
+    for (uint64_t it = 0; it < iters; ++it) {
+        for (long i = 0; i < f->value; ++i)
+            try_push_broadcast_cmd(BROADCAST_CMD, f->pl, &f->sched,
+                BENCH_FREQ);
+        scheduler_run_ready(&f->sched, UINT64_MAX);
+        bench_fix_drain(f->net);
+    }
+    return iters * (uint64_t)f->value;
+}
+
+/* A flooding client: the queue is full, so every line is answered ko */
+static bool setup_feed(bench_fix_t *f)
+{
+    if (!bench_fix_world(f, BROADCAST_SIDE))
+        return false;
+    f->pl = bench_fix_player(f, 0);
+    if (!f->pl)
+        return false;
+    f->pl->q_len = PLAYER_QUEUE_MAX;
+    for (size_t i = 0; i + FEED_LINE_LEN <= sizeof(f->feed);
+        i += FEED_LINE_LEN)
+        memcpy(f->feed + i, FEED_LINE, FEED_LINE_LEN);
+    return true;
+}
+
+/* Frames a stream read value bytes at a time, per line */
+static uint64_t run_feed(bench_fix_t *f, uint64_t iters)
+{
+    size_t chunk = (size_t)f->value;
+
+    for (uint64_t it = 0; it < iters; ++it) {
+        player_feed(f->pl, f->feed, chunk, &f->sched);
+        outbuf_drop_pending(&f->pl->out);
+    }
+    return iters * chunk / FEED_LINE_LEN;
+}
+
+static const bench_case_t CASES[] = {
+    {"broadcast_to_players", "receivers", "broadcast", {1, 8, 32, 128, 0},
+        setup_broadcast, run_broadcast},
+    {"try_push_broadcast_cmd", "queued", "broadcast", {1, 16, 256, 0},
+        setup_broadcast_cmd, run_broadcast_cmd},
+    {"player_feed", "chunk", "line", {8, 64, 512, 0},
+        setup_feed, run_feed},
+};
+
+const bench_case_t *bench_net_cases(size_t *count)
+{
+    *count = sizeof(CASES) / sizeof(CASES[0]);
+    return CASES;
+}
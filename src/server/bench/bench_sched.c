@@ -0,0 +1,79 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench_sched
+*/
+
+#include "bench.h"
+#include "rng.h"
+#include <string.h>
+
+/* Spread over ten minutes at the default frequency, like real commands */
+static const uint32_t TIME_SPAN_MS = 600000;
+
+static void fire_nothing(struct s_player *pl)
+{
+    (void)pl;
+}
+
+static action_t make_action(uint64_t exec_at)
+{
+    action_t act = {0};
+
+    act.exec_at = exec_at;
+    act.fn = fire_nothing;
+    return act;
+}
+
+/* The same exec_at draws for every run, and a heap built from them */
+static bool setup_heap(bench_fix_t *f)
+{
+    rng_t rng;
+
+    rng_seed(&rng, BENCH_SEED, RNG_WORLD);
+    scheduler_init(&f->sched);
+    scheduler_init(&f->snapshot);
+    for (long i = 0; i < f->value; ++i) {
+        f->times[i] = rng_below(&rng, TIME_SPAN_MS);
+        scheduler_push(&f->snapshot, make_action(f->times[i]));
+    }
+    return true;
+}
+
+/* Fills an empty heap up to the case's size, per push */
+static uint64_t run_push(bench_fix_t *f, uint64_t iters)
+{
+    for (uint64_t it = 0; it < iters; ++it) {
+        f->sched.len = 0;
+        for (long i = 0; i < f->value; ++i)
+            scheduler_push(&f->sched, make_action(f->times[i]));
+    }
+    return iters * (uint64_t)f->value;
+}
+
+/* Fires every action of a full heap, per action; the restore is a memcpy */
+static uint64_t run_ready(bench_fix_t *f, uint64_t iters)
+{
+    size_t bytes = (size_t)f->value * sizeof(action_t);
+
+    for (uint64_t it = 0; it < iters; ++it) {
+        memcpy(f->sched.items, f->snapshot.items, bytes);
+        f->sched.len = f->snapshot.len;
+        scheduler_run_ready(&f->sched, UINT64_MAX);
+    }
+    return iters * (uint64_t)f->value;
+}
+
+static const bench_case_t CASES[] = {
+    {"scheduler_push", "heap", "push", {16, 128, 1024, 0},
+        setup_heap, run_push},
+    {"scheduler_run_ready", "heap", "action", {16, 128, 1024, 0},
+        setup_heap, run_ready},
+};
+
+const bench_case_t *bench_sched_cases(size_t *count)
+{
+    *count = sizeof(CASES) / sizeof(CASES[0]);
+    return CASES;
+}
@@ -0,0 +1,90 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** bench_world
+*/
+
+#include "bench.h"
+#include "command_look.h"
+#include "gui.h"
+
+/* Large enough that the level 8 cone never wraps onto itself */
+static const int LOOK_SIDE = 40;
+/* Share of each resource taken between two refills */
+static const uint64_t CONSUMED_DIVISOR = 20;
+
+static bool setup_look(bench_fix_t *f)
+{
+    if (!bench_fix_world(f, LOOK_SIDE))
+        return false;
+    f->pl = bench_fix_player(f, 0);
+    if (!f->pl)
+        return false;
+    f->pl->level = (int)f->value;
+    return true;
+}
+
+/* One Look reply, the tile fragments already cached as in a running game */
+static uint64_t run_look(bench_fix_t *f, uint64_t iters)
+{
+    view_ctx_t v;
+
+    for (uint64_t it = 0; it < iters; ++it) {
+        outbuf_drop_pending(&f->out);
+        v = (view_ctx_t){.out = &f->out, .first = true, .ok = true};
+        traverse_view(f->pl, &v);
+    }
+    return iters;
+}
+
+static bool setup_map(bench_fix_t *f)
+{
+    return bench_fix_world(f, (int)f->value);
+}
+
+/* Takes a twentieth of every resource, then refills the map */
+static uint64_t run_refill(bench_fix_t *f, uint64_t iters)
+{
+    world_t *w = &f->world;
+
+    for (uint64_t it = 0; it < iters; ++it) {
+        for (int id = 0; id < RES_MAX; ++id)
+            w->totals[id] -= w->totals[id] / CONSUMED_DIVISOR;
+        world_periodic_refill(w);
+    }
+    return iters;
+}
+
+static bool setup_gui(bench_fix_t *f)
+{
+    if (!bench_fix_world(f, (int)f->value))
+        return false;
+    f->gui = bench_fix_player(f, -2);
+    return f->gui != NULL;
+}
+
+/* Serializes every tile for one GUI client */
+static uint64_t run_full_map(bench_fix_t *f, uint64_t iters)
+{
+    for (uint64_t it = 0; it < iters; ++it) {
+        gui_broadcast_full_map(f->net);
+        outbuf_drop_pending(&f->gui->out);
+    }
+    return iters;
+}
+
+static const bench_case_t CASES[] = {
+    {"traverse_view", "level", "look", {1, 2, 3, 4, 5, 6, 7, 8},
+        setup_look, run_look},
+    {"world_periodic_refill", "side", "refill", {10, 50, 200, 1000, 0},
+        setup_map, run_refill},
+    {"gui_broadcast_full_map", "side", "map", {10, 50, 200, 0},
+        setup_gui, run_full_map},
+};
+
+const bench_case_t *bench_world_cases(size_t *count)
+{
+    *count = sizeof(CASES) / sizeof(CASES[0]);
+    return CASES;
+}
@@ -0,0 +1,72 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** acceptor
+*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#ifndef ACCEPTOR_H
+    #define ACCEPTOR_H
+
+    #define ACCEPTOR_MAX 16
+
+/**
+ * @brief One accepting thread and its SO_REUSEPORT listener.
+ * @param fd The blocking listening socket owned by the thread.
+ * @param out The write end of the hand-off pipe.
+ * @param running Shared stop flag.
+ * @param thread The thread handle.
+ */
+typedef struct s_acceptor {
+    int fd;
+    int out;
+    atomic_bool *running;
+    pthread_t thread;
+} acceptor_t;
+
+/**
+ * @brief Set of acceptor threads sharing one TCP port.
+ * @param acc The acceptors.
+ * @param count The number of running acceptors.
+ * @param pipe The hand-off pipe; pipe[0] sits in the main poll set.
+ * @param running Cleared to stop the threads.
+ * @note The kernel balances incoming connections across the listeners.
+ * @note Each thread accepts, then passes the descriptor to the game loop,
+ * @note which remains the only owner of the game state and sends WELCOME
+ * @note once it has a player slot for the client.
+ */
+typedef struct s_acceptor_pool {
+    acceptor_t acc[ACCEPTOR_MAX];
+    int count;
+    int pipe[2];
+    atomic_bool running;
+} acceptor_pool_t;
+
+/**
+ * @brief Opens count SO_REUSEPORT listeners on port and starts their threads.
+ * @param pool Pointer to the pool to start.
+ * @param port The TCP port.
+ * @param count The number of acceptors, at most ACCEPTOR_MAX.
+ * @return True if every listener and thread started; on failure the threads
+ *         already started are stopped and joined.
+ */
+bool acceptor_pool_start(acceptor_pool_t *pool, int port, int count);
+/**
+ * @brief Reads the descriptors handed over by the acceptors, without blocking.
+ * @param pool Pointer to the pool.
+ * @param fds Receives the accepted, non-blocking sockets.
+ * @param max The capacity of fds.
+ * @return The number of descriptors read.
+ */
+int acceptor_pool_take(acceptor_pool_t *pool, int *fds, int max);
+/**
+ * @brief Stops and joins the threads, then closes their sockets.
+ * @param pool Pointer to the pool, may never have been started.
+ */
+void acceptor_pool_stop(acceptor_pool_t *pool);
+
+#endif /* ACCEPTOR_H */
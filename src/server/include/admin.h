@@ -0,0 +1,54 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** admin
+*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+#ifndef ADMIN_H
+    #define ADMIN_H
+    #define ADMIN_POLL_MS 200
+    #define ADMIN_REQ_MAX 1024
+
+/**
+ * @brief Local HTTP endpoint serving the server's metrics.
+ * @param fd The listening socket, loopback TCP or AF_UNIX.
+ * @param unix_path The socket file to remove on stop, or NULL.
+ * @param metrics The metrics to export.
+ * @param running Cleared to stop the thread.
+ * @param thread The serving thread.
+ * @param started Set once the thread runs.
+ * @note The thread only reads atomics, it never touches the game state,
+ * @note so a slow scraper cannot stall the game loop.
+ */
+typedef struct s_admin {
+    int fd;
+    const char *unix_path;
+    const metrics_t *metrics;
+    atomic_bool running;
+    pthread_t thread;
+    bool started;
+} admin_t;
+
+/**
+ * @brief Opens the admin endpoint and starts serving it.
+ * @param admin Pointer to the endpoint to start.
+ * @param spec A port number for 127.0.0.1, or the path of a Unix socket.
+ * @param metrics The metrics to export.
+ * @return True if the endpoint listens.
+ * @note GET /metrics answers in the Prometheus text format, GET /drift
+ * @note with the lateness quantiles of each command.
+ */
+bool admin_start(admin_t *admin, const char *spec, const metrics_t *metrics);
+/**
+ * @brief Stops the thread and closes the endpoint.
+ * @param admin Pointer to the endpoint, may never have been started.
+ */
+void admin_stop(admin_t *admin);
+
+#endif /* ADMIN_H */
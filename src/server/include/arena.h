@@ -0,0 +1,131 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** arena - per-tick bump allocator and fixed-size slabs
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef ARENA_H
+    #define ARENA_H
+    #define ARENA_ALIGN _Alignof(max_align_t)
+
+/**
+ * @brief An allocation that did not fit in the arena's block.
+ * @param next The previous spill.
+ * @param data The allocated bytes.
+ */
+typedef struct s_arena_spill {
+    struct s_arena_spill *next;
+    max_align_t data[];
+} arena_spill_t;
+
+/**
+ * @brief Bump allocator for objects that die before the tick ends.
+ * @param base The block handed out by bumping used.
+ * @param cap The size of base.
+ * @param used The bytes of base handed out since the last reset.
+ * @param need The bytes asked since the last reset, spills included.
+ * @param spill The allocations made once base was full.
+ * @note Nothing is freed one by one: arena_reset drops everything at once,
+ * @note and grows base to the last tick's need, so spills stay rare.
+ */
+typedef struct s_arena {
+    char *base;
+    size_t cap;
+    size_t used;
+    size_t need;
+    arena_spill_t *spill;
+} arena_t;
+
+/**
+ * @brief Header in front of every slab block.
+ * @param owner The slab the block belongs to, while allocated.
+ * @param next The next free block, while free.
+ */
+typedef union u_slab_hdr {
+    struct s_slab *owner;
+    union u_slab_hdr *next;
+    max_align_t align;
+} slab_hdr_t;
+
+/**
+ * @brief A run of blocks allocated at once, kept until slab_destroy.
+ * @param next The previously allocated chunk.
+ * @param blocks The blocks.
+ */
+typedef struct s_slab_chunk {
+    struct s_slab_chunk *next;
+    max_align_t blocks[];
+} slab_chunk_t;
+
+/**
+ * @brief Fixed-size block allocator for objects that outlive a tick.
+ * @param stride The size of a block, header included.
+ * @param per_chunk How many blocks a new chunk holds.
+ * @param chunks Every chunk allocated.
+ * @param free The free blocks.
+ * @param live The blocks handed out and not yet freed.
+ * @note Blocks are never returned to malloc before slab_destroy, so a long
+ * @note running server reuses the same memory instead of fragmenting it.
+ */
+typedef struct s_slab {
+    size_t stride;
+    int per_chunk;
+    slab_chunk_t *chunks;
+    slab_hdr_t *free;
+    size_t live;
+} slab_t;
+
+/**
+ * @brief Allocates the arena's block.
+ * @param a The arena.
+ * @param cap The size of the block.
+ * @return False if the block could not be allocated.
+ */
+bool arena_init(arena_t *a, size_t cap);
+/**
+ * @brief Hands out n bytes, aligned for any type.
+ * @param a The arena.
+ * @param n The size of the object.
+ * @return The object, valid until the next arena_reset, or NULL.
+ */
+void *arena_alloc(arena_t *a, size_t n);
+/**
+ * @brief Drops every object of the arena.
+ * @param a The arena.
+ * @note Only call it where no arena pointer is held, at the end of a tick.
+ */
+void arena_reset(arena_t *a);
+/**
+ * @brief Releases the arena's memory.
+ * @param a The arena.
+ */
+void arena_destroy(arena_t *a);
+/**
+ * @brief Sets up an empty slab; no memory is allocated until needed.
+ * @param s The slab.
+ * @param size The size of the objects.
+ * @param per_chunk How many blocks to allocate at once.
+ */
+void slab_init(slab_t *s, size_t size, int per_chunk);
+/**
+ * @brief Hands out a block.
+ * @param s The slab.
+ * @return The block, aligned for any type, or NULL.
+ */
+void *slab_alloc(slab_t *s);
+/**
+ * @brief Gives a block back to the slab it came from.
+ * @param obj The block, or NULL.
+ */
+void slab_free(void *obj);
+/**
+ * @brief Releases every chunk of the slab.
+ * @param s The slab.
+ */
+void slab_destroy(slab_t *s);
+
+#endif /* ARENA_H */
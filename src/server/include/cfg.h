@@ -6,6 +6,7 @@
 */
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifndef CFG_H
     #define CFG_H
@@ -21,6 +22,15 @@ typedef struct s_cfg {
     int team_count;
     int clients_nb;
     int freq;
+    int acceptors;
+    const char *unix_path;
+    const char *shm_name;
+    const char *admin;
+    const char *journal;
+    const char *trace;
+    const char *trace_out;
+    uint64_t seed;
+    bool seeded;
 } cfg_t;
 
 /**
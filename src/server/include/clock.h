@@ -0,0 +1,44 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** clock
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef CLOCK_H
+    #define CLOCK_H
+
+/**
+ * @brief Game time in milliseconds, the single time source of the game.
+ * @return Wall-clock time since the epoch, or the virtual time once
+ *         clock_use_virtual has been called.
+ * @note Every exec_at, hunger deadline and journal time is read from here,
+ * @note so switching to virtual time makes a whole run deterministic.
+ */
+uint64_t clock_now_ms(void);
+/**
+ * @brief Game time in microseconds, for lateness measurements.
+ * @return Wall-clock time since the epoch, or the virtual time.
+ */
+uint64_t clock_now_us(void);
+/**
+ * @brief Stops following the wall clock: time only moves on
+ *        clock_advance.
+ * @param start_ms The virtual time to start from.
+ */
+void clock_use_virtual(uint64_t start_ms);
+/**
+ * @brief Moves the virtual time forward.
+ * @param ms The new time; earlier times are ignored.
+ */
+void clock_advance(uint64_t ms);
+/**
+ * @brief Tells whether the clock is virtual.
+ * @return True after clock_use_virtual.
+ */
+bool clock_is_virtual(void);
+
+#endif /* CLOCK_H */
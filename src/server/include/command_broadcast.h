@@ -17,9 +17,11 @@
  * @brief Context structure for broadcasting messages.
  * @note This structure holds the player who is broadcasting and the message to be sent.
  * @note It is used to encapsulate the broadcast command and its associated player.
+ * @note owner is the ID pl held when the broadcast was scheduled.
  */
 typedef struct broadcast_ctx_s {
     player_t *pl;
+    uint32_t owner;
     char *msg;
 } broadcast_ctx_t;
 
@@ -35,4 +37,13 @@ typedef struct broadcast_ctx_s {
 bool try_push_broadcast_cmd(const char *line, player_t *pl,
     scheduler_t *sched, int freq);
 
+/**
+ * @brief Delivers a broadcast to every player and the GUIs.
+ * @param ctx The emitter and the message text.
+ * @note Each receiver gets "message K, text" with the direction K of the
+ * @note sound as heard from its own tile and orientation.
+ * @note Nothing is sent if the emitter disconnected since ctx was made.
+ */
+void broadcast_to_players(const broadcast_ctx_t *ctx);
+
 #endif /* COMMAND_BROADCAST_H */
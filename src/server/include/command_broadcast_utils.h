@@ -15,19 +15,27 @@
  * @brief Extracts the broadcast text from a line of input.
  * @param line The input line containing the broadcast command.
  * @param prefix The prefix that identifies the broadcast command.
- * @return A dynamically allocated string containing the broadcast text, or NULL if the prefix is not found
- * @note or if the line is empty after the prefix.
- * @note The caller is responsible for freeing the returned string.
+ * @return A pointer into line at the broadcast text, or NULL if the line
+ *         is not a broadcast.
  */
-char *extract_broadcast_text(const char *line, const char *prefix);
+const char *extract_broadcast_text(const char *line, const char *prefix);
 
 /**
  * @brief Creates a broadcast context for a player with the given text.
+ * @param sched The scheduler whose slabs hold the context and its text.
  * @param pl The player who is broadcasting.
- * @param text The broadcast message text.
- * @return A pointer to a dynamically allocated broadcast_ctx_t structure, or NULL on failure.
- * @note The caller is responsible for freeing the returned context.
+ * @param text The broadcast message text, copied.
+ * @return The context, or NULL if the text is longer than SCHED_TEXT_SZ or
+ *         memory ran out.
+ * @note Released with free_broadcast_ctx.
  */
-broadcast_ctx_t *create_broadcast_ctx(player_t *pl, char *text);
+broadcast_ctx_t *create_broadcast_ctx(scheduler_t *sched, player_t *pl,
+    const char *text);
+
+/**
+ * @brief Gives a broadcast context and its text back to their slabs.
+ * @param ctx The context.
+ */
+void free_broadcast_ctx(broadcast_ctx_t *ctx);
 
 #endif /* COMMAND_BROADCAST_UTILS_H */
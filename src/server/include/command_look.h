@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "net_out.h"
 
 #ifndef COMMAND_LOOK_H
     #define COMMAND_LOOK_H
@@ -14,45 +15,23 @@
 struct s_player;
 struct s_net;
 
-/**
- * @brief Context structure for building a buffer for the "Look" command.
- * @note This structure holds the destination buffer, remaining size, and a flag indicating if a space is needed.
- * @note It is used to manage the output buffer while constructing the view of the player's surroundings.
- */
-typedef struct s_buf_ctx {
-    char *dst;
-    size_t rem;
-    bool *need_sp;
-} buf_ctx_t;
-
 /**
  * @brief Context structure for viewing the player's surroundings.
- * @note This structure holds the buffer, its size, a pointer to the length of the buffer, and a flag indicating if it's the first view.
- * @note It is used to manage the output while traversing the player's view in the game world.
+ * @param out The player's output queue the reply is appended to.
+ * @param first Set until the first tile has been written.
+ * @param ok Cleared when the queue could not grow, which stops the traversal.
+ * @note The reply is built in place in the queue, so its size is only bounded by memory.
  */
 typedef struct s_view_ctx {
-    char *buf;
-    size_t size;
-    size_t *len;
-    bool *first;
+    outbuf_t *out;
+    bool first;
+    bool ok;
 } view_ctx_t;
 
 /**
- * @brief Structure representing a position in the game world.
- * @note This structure holds the X and Y coordinates of a position.
- */
-typedef struct s_pos {
-    int x;
-    int y;
-} pos_t;
-
-/**
- * @brief Composes the "Look" command output for a player.
+ * @brief Executes the "Look" command for a player.
  * @param p Pointer to the player structure.
- * @param buf Buffer to store the composed output.
- * @param size Size of the buffer.
- * @return The number of bytes written to the buffer.
- * @note This function generates the view of the player's surroundings and formats it into a string.
+ * @note The view of the player's surroundings is appended to its output queue, then flushed.
  */
 void cmd_look(struct s_player *p);
 
@@ -66,28 +45,15 @@ void cmd_look(struct s_player *p);
 int wrap_coord(int v, int max);
 
 /**
- * @brief Builds a tile representation for a net at a specific position.
+ * @brief Appends the content of a tile to an output queue.
  * @param net Pointer to the net structure.
  * @param x The X coordinate of the tile.
  * @param y The Y coordinate of the tile.
- * @param b Pointer to the buffer context for building the tile.
- * @return The size of the built tile in bytes.
- * @note This function constructs a string representation of a tile based on the net's properties and position.
- */
-size_t build_tile(const struct s_net *net, int x, int y,
-    buf_ctx_t *b);
-
-/**
- * @brief Coordinates a position based on the player's direction and distance.
- * @param pl Pointer to the player structure.
- * @param dist The distance to move in the specified direction.
- * @param off The offset to apply to the position.
- * @param pos Pointer to the position structure to store the result.
- * @note This function calculates the new position based on the player's direction and distance, applying the
- * @note offset to the resulting coordinates.
+ * @param out The output queue to append to.
+ * @return True on success, false if the queue could not grow.
+ * @note The tile's fragment is cached and only rebuilt when the tile's version changed since.
  */
-void coord_for_dir(const struct s_player *pl, int dist, int off,
-    pos_t *pos);
+bool build_tile(const struct s_net *net, int x, int y, outbuf_t *out);
 
 /**
  * @brief Appends a tile representation to the view context.
@@ -101,22 +67,12 @@ void coord_for_dir(const struct s_player *pl, int dist, int off,
 void append_tile(const struct s_player *pl, int tx, int ty,
     view_ctx_t *v);
 
-/**
- * @brief Adds a line to the view context for a player.
- * @param pl Pointer to the player structure.
- * @param dist The distance from the player to the line.
- * @param v Pointer to the view context to which the line will be added.
- * @note This function constructs a line of sight for the player, adding it to the view context.
- * @note It manages the output buffer and ensures proper formatting of the line.
- */
-void add_line(const struct s_player *pl, int dist, view_ctx_t *v);
-
 /**
  * @brief Traverses the player's view and builds the output buffer.
  * @param pl Pointer to the player structure.
  * @param v Pointer to the view context containing the output buffer and its properties.
- * @note This function iterates through the player's surroundings, building the output buffer with tile representations
- * @note and lines of sight, managing the formatting and spacing as needed.
+ * @note Tile positions come from the precomputed LOOK_TABLE cone of the player's orientation,
+ * @note so the only per-tile coordinate work left is the wrap around the map edges.
  */
 void traverse_view(const struct s_player *pl, view_ctx_t *v);
 
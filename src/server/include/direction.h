@@ -0,0 +1,67 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** direction
+*/
+
+#include <stdint.h>
+#include "world.h"
+
+#ifndef DIRECTION_H
+    #define DIRECTION_H
+
+    #define DIR_BATCH_MAX 128
+
+struct s_player;
+
+/**
+ * @brief Column step of each orientation (north, east, south, west).
+ */
+extern const int DIR_DX[4];
+/**
+ * @brief Row step of each orientation (north, east, south, west).
+ */
+extern const int DIR_DY[4];
+
+/**
+ * @brief Receivers of one broadcast, stored as a structure of arrays.
+ * @param who The receiving players.
+ * @param x The X coordinate of each receiver.
+ * @param y The Y coordinate of each receiver.
+ * @param dir The orientation of each receiver.
+ * @param code The direction code computed for each receiver (0-8).
+ * @param count The number of receivers gathered.
+ * @note Keeping positions in flat arrays lets the direction pass run as a
+ * @note single branch-free loop the compiler can vectorize.
+ */
+typedef struct s_dir_batch {
+    struct s_player *who[DIR_BATCH_MAX];
+    int x[DIR_BATCH_MAX];
+    int y[DIR_BATCH_MAX];
+    int dir[DIR_BATCH_MAX];
+    uint8_t code[DIR_BATCH_MAX];
+    int count;
+} dir_batch_t;
+
+/**
+ * @brief Computes the tile a sound reaches a receiver from.
+ * @param w Pointer to the world, for the wrap-around.
+ * @param ex The X coordinate of the emitter.
+ * @param ey The Y coordinate of the emitter.
+ * @param rcv The receiving player.
+ * @return 0 when both share a tile, otherwise 1-8 counter-clockwise from
+ *         the receiver's front.
+ */
+int sound_direction(const world_t *w, int ex, int ey,
+    const struct s_player *rcv);
+/**
+ * @brief Computes the direction code of every receiver in a batch.
+ * @param b Pointer to the gathered receivers.
+ * @param w Pointer to the world, for the wrap-around.
+ * @param ex The X coordinate of the emitter.
+ * @param ey The Y coordinate of the emitter.
+ */
+void dir_batch_compute(dir_batch_t *b, const world_t *w, int ex, int ey);
+
+#endif /* DIRECTION_H */
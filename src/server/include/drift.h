@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** drift
+*/
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "net_out.h"
+#include "scheduler.h"
+
+#ifndef DRIFT_H
+    #define DRIFT_H
+    #define DRIFT_SUB_BITS 4
+    #define DRIFT_SUB (1 << DRIFT_SUB_BITS)
+    #define DRIFT_MAX_EXP 40
+    #define DRIFT_BUCKETS ((DRIFT_MAX_EXP - DRIFT_SUB_BITS + 1) * DRIFT_SUB)
+
+/**
+ * @brief Log-linear histogram of action lateness, in microseconds.
+ * @param counts Values below DRIFT_SUB have a bucket each; above, every
+ *        power of two is split in DRIFT_SUB equal buckets, so a quantile
+ *        is known within 1 / DRIFT_SUB of its value.
+ * @param total The number of values recorded.
+ * @param max_us The largest value recorded.
+ * @note Same idea as an HDR histogram with 1 significant hex digit:
+ * @note constant-time recording, fixed memory, mergeable.
+ */
+typedef struct s_drift_hist {
+    _Atomic uint64_t counts[DRIFT_BUCKETS];
+    _Atomic uint64_t total;
+    _Atomic uint64_t max_us;
+} drift_hist_t;
+
+/**
+ * @brief Records how late an action fired.
+ * @param h The histogram of the action's kind.
+ * @param us The lateness, now minus exec_at, in microseconds.
+ * @note Single writer: the game loop.
+ */
+void drift_record(drift_hist_t *h, uint64_t us);
+/**
+ * @brief Estimates a quantile.
+ * @param h The histogram.
+ * @param q The quantile, between 0 and 1.
+ * @return The upper bound of the bucket holding the quantile, capped at
+ *         the maximum, or 0 if nothing was recorded.
+ */
+uint64_t drift_quantile(const drift_hist_t *h, double q);
+/**
+ * @brief Appends one line per action kind: count, p50, p90, p99, p99.9
+ *        and max lateness in microseconds.
+ * @param hists The histograms, indexed by act_kind_t.
+ * @param ob The buffer receiving the table.
+ * @return True on success, false if the buffer could not grow.
+ */
+bool drift_render(const drift_hist_t hists[ACT_KINDS], outbuf_t *ob);
+
+#endif /* DRIFT_H */
@@ -9,13 +9,38 @@
 
 #ifndef EGG_H
     #define EGG_H
-    #define EGG_MAX 1024
+    #define EGG_MIN_CAP 64
 
 struct s_net;
+struct s_world;
+
+/**
+ * @brief Links of an egg in one of the pool's intrusive lists.
+ * @param prev The previous egg's slot, or -1.
+ * @param next The next egg's slot, or -1.
+ */
+typedef struct s_egg_link {
+    int prev;
+    int next;
+} egg_link_t;
+
+/**
+ * @brief The two lists every live egg belongs to.
+ */
+typedef enum e_egg_list {
+    EGG_BY_TEAM,
+    EGG_BY_TILE,
+    EGG_LISTS
+} egg_list_t;
 
 /**
  * @brief Structure representing an egg in the game.
- * @note This structure holds the ID, position (x, y), and team index of the egg.
+ * @param id The egg ID shown to GUIs.
+ * @param x The X coordinate of the egg.
+ * @param y The Y coordinate of the egg.
+ * @param team_idx The index of the team that owns the egg.
+ * @param link The egg's place in its team's and its tile's list; a free
+ *        slot uses link[EGG_BY_TEAM].next to chain the free list.
  * @note It is used to manage eggs created by players in the game world.
  */
 typedef struct s_egg {
@@ -23,18 +48,55 @@ typedef struct s_egg {
     int x;
     int y;
     int team_idx;
+    egg_link_t link[EGG_LISTS];
 } egg_t;
 
+/**
+ * @brief Growable store of the eggs laid on the map.
+ * @param eggs The egg slots, doubled when full.
+ * @param cap The number of slots.
+ * @param count The number of live eggs.
+ * @param free_head The first free slot, or -1.
+ * @param team_head The first egg of each team, or -1.
+ * @param world The map, each tile holds the head of its egg list.
+ * @param next_id The ID to be assigned to the next egg created.
+ * @note Eggs are addressed by slot so that growing the store never
+ * @note invalidates a list; hatching is O(1) and clearing a tile is
+ * @note O(eggs on that tile).
+ */
+typedef struct s_egg_pool {
+    egg_t *eggs;
+    int cap;
+    int count;
+    int free_head;
+    int *team_head;
+    struct s_world *world;
+    int next_id;
+} egg_pool_t;
+
+/**
+ * @brief Allocates the per-team list heads.
+ * @param pool Pointer to the pool to initialize.
+ * @param team_cnt The number of teams.
+ * @param world The map the eggs are laid on.
+ * @return True on success, false if an allocation failed.
+ */
+bool egg_pool_init(egg_pool_t *pool, int team_cnt, struct s_world *world);
+/**
+ * @brief Releases the pool's memory.
+ * @param pool Pointer to the pool.
+ */
+void egg_pool_destroy(egg_pool_t *pool);
+
 /**
  * @brief Creates an egg at the specified position for the given team.
  * @param net Pointer to the network structure.
  * @param x The X coordinate where the egg will be created.
  * @param y The Y coordinate where the egg will be created.
  * @param team_idx The index of the team that owns the egg.
- * @return True if the egg was successfully created, false otherwise.
- * @note This function initializes a new egg and adds it to the game world.
+ * @return The new egg, valid until the next egg_create, or NULL on failure.
  */
-bool egg_create(struct s_net *net, int x, int y, int team_idx);
+const egg_t *egg_create(struct s_net *net, int x, int y, int team_idx);
 
 /**
  * @brief Hatches an egg for the specified team.
@@ -47,4 +109,12 @@ bool egg_create(struct s_net *net, int x, int y, int team_idx);
  */
 bool egg_hatch(struct s_net *net, int team_idx, int *x, int *y);
 
+/**
+ * @brief Destroys every egg on a tile, notifying GUIs.
+ * @param net Pointer to the network structure.
+ * @param x The X coordinate of the tile.
+ * @param y The Y coordinate of the tile.
+ */
+void egg_destroy_on_tile(struct s_net *net, int x, int y);
+
 #endif /* EGG_H */
@@ -14,15 +14,33 @@
 
     #define GUI_BUF_SZ 128
     #define IS_GUI(p) ((p) && (p)->authed && (p)->team_idx == -2)
-    #define PIC_BUF_SZ 256
+    /* "pic X Y L" and one " #id" per participant, at their longest */
+    #define PIC_HEAD_MAX 40
+    #define PIC_ID_MAX 12
+    #define GUI_OUTQ_MAX (256 * 1024)
+    #define GUI_TILE_BYTES 64
 
 /**
  * @brief Sends the initial map and player information to the GUI client.
  * @param net Pointer to the network structure containing the game state.
- * @param fd The file descriptor of the GUI client socket.
+ * @param gui Pointer to the GUI client receiving the snapshot.
  * @note This function sends the full map and player information to the GUI client upon connection.
+ * @note It is also used as the resync snapshot when a slow GUI overflows its queue.
  */
-void gui_send_initial(net_t *net, int fd);
+void gui_send_initial(net_t *net, player_t *gui);
+/**
+ * @brief Serializes the full world state as seen by a freshly connected GUI.
+ * @param net Pointer to the network structure containing the game state.
+ * @param ob The buffer the msz/bct/tna/pnw/sgt lines are appended to.
+ * @return False if the buffer could not grow.
+ */
+bool gui_build_snapshot(const net_t *net, outbuf_t *ob);
+/**
+ * @brief Publishes a snapshot to the shared-memory feed as its new keyframe.
+ * @param net Pointer to the network structure containing the game state.
+ * @note Does nothing when the server runs without -m.
+ */
+void gui_ring_keyframe(net_t *net);
 /**
  * @brief Broadcasts the full map to all GUI clients.
  * @param net Pointer to the network structure containing the game state.
@@ -124,11 +142,41 @@ void gui_broadcast_plv(net_t *net, const player_t *pl);
 void gui_broadcast_pie(net_t *net, int x, int y, int result);
 
 /**
- * @brief Socket printf function to send formatted data to a socket.
- * @param fd The file descriptor of the socket.
+ * @brief Printf function appending formatted data to an output buffer.
+ * @param ob The buffer, a GUI queue or the shared-memory keyframe scratch.
  * @param fmt The format string for the data to be sent.
+ * @return False if the buffer could not grow.
+ * @note The data bypasses the backlog limit, it is meant for snapshots.
+ * @note The line is never cut, whatever its length.
+ */
+bool sock_printf(outbuf_t *ob, const char *fmt, ...);
+/**
+ * @brief Appends the "bct" line of a tile.
+ * @param ob The buffer.
+ * @param x The X coordinate of the tile.
+ * @param y The Y coordinate of the tile.
+ * @param t The tile.
+ * @return False if the buffer could not grow.
  */
-void sock_printf(int fd, const char *fmt, ...);
+bool gui_write_bct(outbuf_t *ob, int x, int y, const tile_t *t);
+/**
+ * @brief Appends the "bct" line of every tile, row by row.
+ * @param ob The buffer.
+ * @param w The world.
+ * @return False if the buffer could not grow.
+ */
+bool gui_write_map(outbuf_t *ob, const world_t *w);
+/**
+ * @brief Queues a message for one GUI client, applying the backlog policy.
+ * @param net Pointer to the network structure containing the game state.
+ * @param gui Pointer to the GUI client.
+ * @param msg The message to be sent.
+ * @param n The length of the message.
+ * @note When the backlog would exceed the limit, queued deltas are discarded
+ * @note and replaced by a resync snapshot; a GUI overflowing again before its
+ * @note snapshot was drained is marked doomed and dropped by the poll loop.
+ */
+void gui_send(net_t *net, player_t *gui, const char *msg, size_t n);
 /**
  * @brief Broadcasts a message to all GUI clients.
  * @param net Pointer to the network structure containing the game state.
@@ -137,6 +185,13 @@ void sock_printf(int fd, const char *fmt, ...);
  * @note This function sends a message to all connected GUI clients.
  */
 void broadcast(net_t *net, const char *msg, size_t n);
+/**
+ * @brief Formats a line and broadcasts it to all GUI clients.
+ * @param net Pointer to the network structure containing the game state.
+ * @param fmt The format string of the line.
+ * @note A line longer than GUI_BUF_SZ is built in the tick arena, whole.
+ */
+void broadcast_printf(net_t *net, const char *fmt, ...);
 
 /**
  * @brief Structure representing a picture to be sent to the GUI.
@@ -153,7 +208,7 @@ typedef struct {
     int x;
     int y;
     int level;
-    const int *ids;
+    const uint32_t *ids;
     size_t count;
 } gui_pic_t;
 
@@ -164,7 +219,7 @@ typedef struct {
  */
 typedef struct {
     int egg_id;
-    int player_id;
+    uint32_t player_id;
     int x;
     int y;
 } gui_enw_t;
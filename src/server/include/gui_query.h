@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** gui_query - commands sent by GUI clients
+*/
+
+#include <stdbool.h>
+#include "net_poll.h"
+#include "player.h"
+
+#ifndef GUI_QUERY_H
+    #define GUI_QUERY_H
+
+/**
+ * @brief Maps a GUI command to the function answering it.
+ * @param name The command, first word of the line.
+ * @param fn Answers the command; args points past the name. Returns false
+ *        on bad parameters, answered "sbp".
+ */
+typedef struct s_gui_query {
+    const char *name;
+    bool (*fn)(net_t *net, player_t *gui, const char *args);
+} gui_query_t;
+
+/**
+ * @brief Answers one line sent by a GUI client.
+ * @param net Pointer to the network structure containing the game state.
+ * @param gui The GUI client.
+ * @param line The command, without its newline.
+ * @note Queries are answered at once, outside the scheduler. An unknown
+ * @note command is answered "suc", bad parameters "sbp".
+ */
+void gui_command(net_t *net, player_t *gui, const char *line);
+
+#endif /* GUI_QUERY_H */
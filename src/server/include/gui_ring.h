@@ -0,0 +1,104 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** gui_ring
+*/
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "net_out.h"
+
+#ifndef GUI_RING_H
+    #define GUI_RING_H
+
+    #define GUI_RING_MAGIC 0x5a52494eU
+    #define GUI_RING_VERSION 1U
+    #define GUI_RING_HDR_SZ 128
+    #define GUI_RING_MIN_CAP ((size_t)4 << 20)
+
+/**
+ * @brief Header at the start of the shared-memory GUI feed.
+ * @param magic GUI_RING_MAGIC, published last once the segment is ready.
+ * @param version Layout version, GUI_RING_VERSION.
+ * @param capacity Size of the delta ring in bytes, a power of two.
+ * @param kf_capacity Size of each of the two keyframe slots.
+ * @param head Total bytes ever published; readers may consume up to it.
+ * @param reserve Total bytes the writer has started to copy; a reader whose
+ *        copy started before reserve - capacity was overwritten meanwhile.
+ * @param kf_seq Number of keyframes published, keyframe number n lives in
+ *        slot n & 1 so the latest one is in slot kf_seq & 1.
+ * @param kf_reserve Number of keyframes the writer has started to copy.
+ * @param kf_at Stream offset each keyframe is a snapshot of.
+ * @param kf_len Length of each keyframe.
+ * @note Offsets grow forever, the ring position is offset & (capacity - 1).
+ * @note Layout: header, delta ring at GUI_RING_HDR_SZ, then the two slots.
+ */
+typedef struct s_gui_ring_hdr {
+    _Atomic uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t kf_capacity;
+    _Atomic uint64_t head;
+    _Atomic uint64_t reserve;
+    _Atomic uint64_t kf_seq;
+    _Atomic uint64_t kf_reserve;
+    uint64_t kf_at[2];
+    uint64_t kf_len[2];
+} gui_ring_hdr_t;
+
+/**
+ * @brief Writer side of the shared-memory GUI feed.
+ * @param name The POSIX shared memory name, with its leading '/'.
+ * @param hdr The mapped header.
+ * @param data The mapped delta ring.
+ * @param map_len The length of the whole mapping.
+ * @param head Local copy of hdr->head, the server is the only writer.
+ * @param scratch Reused buffer the keyframe snapshots are built into.
+ * @note The feed is one-way: co-located GUIs read it without any socket.
+ * @note Keyframes live outside the delta stream, so readers keeping up never
+ * @note see them; a lapped reader reloads the latest one and resumes at its
+ * @note stream offset.
+ */
+typedef struct s_gui_ring {
+    char *name;
+    gui_ring_hdr_t *hdr;
+    char *data;
+    size_t map_len;
+    uint64_t head;
+    outbuf_t scratch;
+} gui_ring_t;
+
+/**
+ * @brief Creates the shared-memory segment and maps it.
+ * @param name The segment name, a leading '/' is added when missing.
+ * @param kf_cap The size of a keyframe slot, the largest snapshot expected.
+ * @return The ring, or NULL on failure.
+ * @note The delta ring holds at least four keyframes worth of bytes.
+ * @note A stale segment with the same name is replaced.
+ */
+gui_ring_t *gui_ring_open(const char *name, size_t kf_cap);
+/**
+ * @brief Publishes a message to the ring.
+ * @param ring The ring, may be NULL.
+ * @param msg The message bytes.
+ * @param n The length of the message.
+ * @note Messages larger than a keyframe slot are dropped.
+ */
+void gui_ring_write(gui_ring_t *ring, const char *msg, size_t n);
+/**
+ * @brief Publishes a full snapshot of the state at the current stream offset.
+ * @param ring The ring, may be NULL.
+ * @param msg The snapshot bytes.
+ * @param n The length of the snapshot, dropped if larger than a slot.
+ */
+void gui_ring_write_keyframe(gui_ring_t *ring, const char *msg, size_t n);
+/**
+ * @brief Unmaps and unlinks the segment, then frees the ring.
+ * @param ring The ring, may be NULL.
+ */
+void gui_ring_close(gui_ring_t *ring);
+
+#endif /* GUI_RING_H */
@@ -18,5 +18,12 @@
  * @param now The current time in milliseconds.
  */
 void hunger_check(net_t *net, uint64_t now);
+/**
+ * @brief Finds when the next player has to eat.
+ * @param net Pointer to the network structure containing the game state.
+ * @return The earliest meal time in milliseconds, or UINT64_MAX if no
+ *         player is on the map.
+ */
+uint64_t hunger_next_due(const net_t *net);
 
 #endif /* HUNGER_H */
@@ -10,10 +10,12 @@
 #include "player.h"
 #include "world.h"
 #include "net_poll.h"
+#include "ritual.h"
 
 #ifndef INCANTATION_H
     #define INCANTATION_H
     #define INCANTATION_DELAY 300
+    #define INCANTATION_MAX_LEVEL 8
 
 /**
  * @brief Structure representing the requirements for an incantation.
@@ -25,31 +27,17 @@ typedef struct req_s {
     int stones[RES_MAX];
 } req_t;
 
-/**
- * @brief Structure representing the context for an incantation.
- * @param initiator Pointer to the player initiating the incantation.
- * @param x The X coordinate of the tile where the incantation is taking place.
- * @param y The Y coordinate of the tile where the incantation is taking place.
- * @param level The level of the incantation.
- */
-typedef struct inc_ctx_s {
-    player_t *initiator;
-    int x;
-    int y;
-    int level;
-} inc_ctx_t;
-
 /**
  * @brief Structure representing the result context of an incantation.
  * @param net Pointer to the network structure containing the game state.
- * @param ctx Pointer to the incantation context.
+ * @param ritual The incantation and its participants.
  * @param tile Pointer to the tile where the incantation is taking place.
- * @param init Pointer to the player who initiated the incantation.
+ * @param init The initiator, or NULL if it disconnected.
  * @param success Indicates whether the incantation was successful.
  */
 typedef struct inc_result_ctx_s {
     net_t *net;
-    inc_ctx_t *ctx;
+    ritual_t *ritual;
     tile_t *tile;
     player_t *init;
     int success;
@@ -65,17 +53,18 @@ bool try_push_incantation_cmd(const char *line,
     scheduler_t *sched,
     int freq);
 
-extern const req_t REQS[8];
+extern const req_t REQS[INCANTATION_MAX_LEVEL];
 
 /**
- * @brief Schedules an incantation for a player.
+ * @brief Schedules the end of a ritual.
+ * @param r The ritual, which is the scheduled action's context.
  * @param pl Pointer to the player initiating the incantation.
  * @param sched Pointer to the scheduler where the incantation will be scheduled.
  * @param freq The frequency of the scheduler.
  * @return True if the incantation was successfully scheduled, false otherwise.
+ * @note On failure, the caller still owns the ritual.
  */
-bool schedule_incantation(struct s_player *pl,
-    scheduler_t *sched,
-    int freq);
+bool schedule_incantation(ritual_t *r, struct s_player *pl,
+    scheduler_t *sched, int freq);
 
 #endif /* INCANTATION_H */
@@ -40,12 +40,14 @@ typedef struct s_item_params {
 /**
  * @brief Structure representing the context for an item operation.
  * @param pl Pointer to the player performing the operation.
+ * @param owner The ID pl held when the operation was scheduled.
  * @param id The resource ID associated with the item.
  * @param take Indicates whether the operation is a take action.
  * @note This structure contains the player, resource ID, and whether the operation is a take action.
  */
 typedef struct s_item_ctx {
     struct s_player *pl;
+    uint32_t owner;
     res_t id;
     bool take;
 } item_ctx_t;
@@ -26,17 +26,13 @@ static inline bool ih_str_eq(const char *a, const char *b)
     return !strcmp(a, b);
 }
 
-/**
- * @brief Gets the current time in milliseconds.
- * @return The current time in milliseconds since the epoch.
- */
-uint64_t ih_now_ms(void);
 /**
  * @brief Sends a reply message to a client.
- * @param fd The file descriptor of the client socket.
+ * @param p The player to reply to.
  * @param msg The message to be sent.
+ * @note The message is queued behind the player's earlier replies.
  */
-void ih_reply(int fd, const char *msg);
+void ih_reply(player_t *p, const char *msg);
 /**
  * @brief Converts a resource name string to its corresponding resource ID.
  * @param word The resource name string.
@@ -0,0 +1,165 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** journal
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "net_out.h"
+
+#ifndef JOURNAL_H
+    #define JOURNAL_H
+    #define JOURNAL_MAGIC "ZJNL"
+    #define JOURNAL_VERSION 3
+    #define JOURNAL_FLUSH_AT (64 * 1024)
+    #define JOURNAL_KEYFRAME_BYTES (1024 * 1024)
+
+struct s_net;
+struct s_player;
+
+/**
+ * @brief Journal record types.
+ * @note Every record is: u8 type, varint ms since the previous record,
+ * @note then the varints listed below (LEB128, unsigned).
+ * @note J_KEYFRAME: the frequency, w * h tiles of 7 resource counts
+ *       (row-major), player count, then per player id, x, y, orientation,
+ *       level, team, 7 inventory counts, then egg count, then per egg id,
+ *       x, y, team.
+ * @note J_SPAWN: id, x, y, orientation, level, team, 7 inventory counts.
+ * @note J_MOVE: id, x, y, orientation.
+ * @note J_TAKE, J_SET: id, resource.
+ * @note J_EAT: id, units of food eaten.
+ * @note J_INC_START: x, y, level, count, then count player ids.
+ * @note J_INC_END: x, y, result, then the tile's 7 resource counts.
+ * @note J_LEVEL: id, new level.
+ * @note J_EGG_LAY: egg id, player id, x, y.
+ * @note J_EGG_HATCH, J_EGG_DIE: egg id.
+ * @note J_DEATH, J_LEAVE: id; a starving player's J_DEATH comes first.
+ * @note J_BROADCAST: id, length, then length raw bytes.
+ * @note J_DROP: x, y, resource; one unit added by a refill.
+ * @note J_FREQ: the new frequency, set by a GUI's sst.
+ * @note Orientations are 1 to 4 (N, E, S, W) and teams are indexes into
+ * @note the header's list, as in the GUI protocol.
+ */
+typedef enum e_jrec {
+    J_KEYFRAME = 1,
+    J_SPAWN,
+    J_MOVE,
+    J_TAKE,
+    J_SET,
+    J_EAT,
+    J_INC_START,
+    J_INC_END,
+    J_LEVEL,
+    J_EGG_LAY,
+    J_EGG_HATCH,
+    J_EGG_DIE,
+    J_DEATH,
+    J_LEAVE,
+    J_BROADCAST,
+    J_DROP,
+    J_FREQ
+} jrec_t;
+
+/**
+ * @brief Buffered append-only writer of the match journal.
+ * @param fd The journal file.
+ * @param buf Records not yet written, flushed past JOURNAL_FLUSH_AT.
+ * @param last_ms The wall-clock time of the previous record.
+ * @param since_keyframe Bytes appended since the last keyframe.
+ * @param failed Set after a write error; the journal then stops.
+ * @note The file starts with JOURNAL_MAGIC, u8 JOURNAL_VERSION, then the
+ * @note varints width, height, freq, seed, start time in ms and team
+ * @note count, each team name as a varint length and its bytes.
+ * @note Appending a record is a few stores into a memory buffer; the
+ * @note file only sees one write per JOURNAL_FLUSH_AT bytes.
+ */
+typedef struct s_journal {
+    int fd;
+    outbuf_t buf;
+    uint64_t last_ms;
+    uint64_t since_keyframe;
+    bool failed;
+} journal_t;
+
+/**
+ * @brief Creates the journal file and writes its header and a keyframe.
+ * @param path The file to create, truncated if it exists.
+ * @param net The server state, fully initialized.
+ * @return The journal, or NULL on failure.
+ */
+journal_t *journal_open(const char *path, const struct s_net *net);
+/**
+ * @brief Writes the pending records and closes the file.
+ * @param j The journal, may be NULL.
+ */
+void journal_close(journal_t *j);
+/**
+ * @brief Appends a record.
+ * @param j The journal, may be NULL.
+ * @param type The record type.
+ * @param fields The record's varint fields, see jrec_t.
+ * @param n The number of fields.
+ */
+void journal_event(journal_t *j, jrec_t type, const uint64_t *fields,
+    size_t n);
+/**
+ * @brief Appends a player's position record.
+ * @param j The journal, may be NULL.
+ * @param type J_MOVE, or J_SPAWN to add the level, team and inventory.
+ * @param pl The player.
+ */
+void journal_player(journal_t *j, jrec_t type, const struct s_player *pl);
+/**
+ * @brief Appends a broadcast record with its text.
+ * @param j The journal, may be NULL.
+ * @param id The emitter's player ID.
+ * @param text The message.
+ */
+void journal_broadcast(journal_t *j, uint32_t id, const char *text);
+/**
+ * @brief Starts a record: its type and the time since the previous one.
+ * @param j The journal, may be NULL.
+ * @param type The record type.
+ * @return True if the record's fields should follow, false if the journal
+ *         is absent or failed.
+ * @note Writes the buffer out first once it holds JOURNAL_FLUSH_AT bytes.
+ */
+bool journal_record(journal_t *j, jrec_t type);
+/**
+ * @brief Appends one varint to the record being written.
+ * @param j The journal.
+ * @param v The value.
+ */
+void journal_varint(journal_t *j, uint64_t v);
+/**
+ * @brief Appends varints to the record being written.
+ * @param j The journal.
+ * @param fields The values.
+ * @param n The number of values.
+ */
+void journal_fields(journal_t *j, const uint64_t *fields, size_t n);
+/**
+ * @brief Writes the buffered records to the file.
+ * @param j The journal.
+ */
+void journal_write_pending(journal_t *j);
+/**
+ * @brief Appends a full snapshot of the map, players and eggs.
+ * @param j The journal, may be NULL.
+ * @param net The server state.
+ * @note A reader can start from any keyframe and apply what follows.
+ */
+void journal_keyframe(journal_t *j, const struct s_net *net);
+/**
+ * @brief Appends a keyframe once JOURNAL_KEYFRAME_BYTES were written since
+ *        the previous one.
+ * @param j The journal, may be NULL.
+ * @param net The server state.
+ */
+void journal_maybe_keyframe(journal_t *j, const struct s_net *net);
+
+#endif /* JOURNAL_H */
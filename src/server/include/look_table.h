@@ -0,0 +1,45 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** look_table
+*/
+
+#include <stdint.h>
+
+#ifndef LOOK_TABLE_H
+    #define LOOK_TABLE_H
+
+    #define LOOK_MAX_LEVEL 8
+    #define LOOK_TILES(level) (((level) + 1) * ((level) + 1))
+
+/**
+ * @brief Offset of a visible tile relative to the looking player.
+ */
+typedef struct s_look_off {
+    int8_t dx;
+    int8_t dy;
+} look_off_t;
+
+/**
+ * @brief Look cone offsets per orientation (0 north, 1 east, 2 south,
+ * 3 west), in the order tiles are reported.
+ * @note A player of level l sees the first LOOK_TILES(l) entries.
+ */
+extern const look_off_t LOOK_TABLE[4][LOOK_TILES(LOOK_MAX_LEVEL)];
+
+/**
+ * @brief Wraps a coordinate at most one map length out of bounds.
+ * @param v The coordinate, in [-max, 2 * max).
+ * @param max The map dimension.
+ * @return The coordinate in [0, max).
+ * @note Branch-free; valid for any Look offset once max >= LOOK_MAX_LEVEL.
+ */
+static inline int look_wrap_near(int v, int max)
+{
+    v += max & -(v < 0);
+    v -= max & -(v >= max);
+    return v;
+}
+
+#endif /* LOOK_TABLE_H */
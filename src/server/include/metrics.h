@@ -0,0 +1,163 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** metrics
+*/
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "net_out.h"
+#include "scheduler.h"
+#include "drift.h"
+
+#ifndef METRICS_H
+    #define METRICS_H
+    #define METRICS_LAT_BUCKETS 21
+    #define METRICS_CLIENTS 128
+
+/**
+ * @brief Scalar server metrics, counters and gauges alike.
+ */
+typedef enum e_metric {
+    M_SCHED_LEN,
+    M_SCHED_HIGH_WATER,
+    M_SCHED_PUSH_FAILED,
+    M_CMD_REJECTED,
+    M_CLIENTS,
+    M_GUI_CLIENTS,
+    M_GUI_BYTES,
+    M_GUI_RESYNCS,
+    METRIC_COUNT
+} metric_t;
+
+/**
+ * @brief Per-connection I/O counters.
+ */
+typedef enum e_metric_io {
+    MIO_BYTES_IN,
+    MIO_READS,
+    MIO_BYTES_OUT,
+    MIO_WRITES,
+    MIO_COUNT
+} metric_io_t;
+
+/**
+ * @brief I/O statistics of one player slot.
+ * @param id The ID of the connection using the slot, 0 when it is free.
+ * @param io The counters, reset when a connection takes the slot.
+ */
+typedef struct s_metrics_client {
+    _Atomic uint32_t id;
+    _Atomic uint64_t io[MIO_COUNT];
+} metrics_client_t;
+
+/**
+ * @brief Server health counters, exported by the admin endpoint.
+ * @param values The scalar metrics, indexed by metric_t.
+ * @param actions The number of actions fired, per kind.
+ * @param drift How late the actions fired, per kind.
+ * @param loop_hist Wake-up handling time, bucket i counts the iterations
+ *        that took at most 2^i microseconds, the last one the rest.
+ * @param loop_sum_us The total handling time, in microseconds.
+ * @param clients The I/O statistics of each player slot.
+ * @note Only the game loop writes, with relaxed atomics: the admin thread
+ * @note reads a consistent value of each counter without any lock.
+ */
+typedef struct s_metrics {
+    _Atomic uint64_t values[METRIC_COUNT];
+    _Atomic uint64_t actions[ACT_KINDS];
+    drift_hist_t drift[ACT_KINDS];
+    _Atomic uint64_t loop_hist[METRICS_LAT_BUCKETS];
+    _Atomic uint64_t loop_sum_us;
+    metrics_client_t clients[METRICS_CLIENTS];
+} metrics_t;
+
+/**
+ * @brief Adds to a counter or a gauge.
+ * @param m Pointer to the metrics.
+ * @param id The metric.
+ * @param n The amount to add, wraps around to subtract.
+ */
+static inline void metrics_add(metrics_t *m, metric_t id, uint64_t n)
+{
+    atomic_fetch_add_explicit(&m->values[id], n, memory_order_relaxed);
+}
+
+/**
+ * @brief Sets a gauge.
+ * @param m Pointer to the metrics.
+ * @param id The metric.
+ * @param v The new value.
+ */
+static inline void metrics_set(metrics_t *m, metric_t id, uint64_t v)
+{
+    atomic_store_explicit(&m->values[id], v, memory_order_relaxed);
+}
+
+/**
+ * @brief Reads a metric.
+ * @param m Pointer to the metrics.
+ * @param id The metric.
+ * @return The current value.
+ */
+static inline uint64_t metrics_get(const metrics_t *m, metric_t id)
+{
+    return atomic_load_explicit(&m->values[id], memory_order_relaxed);
+}
+
+/**
+ * @brief Monotonic time for latency measurements.
+ * @return Microseconds since an arbitrary point.
+ */
+uint64_t metrics_now_us(void);
+/**
+ * @brief Counts a fired action and records how late it fired.
+ * @param m Pointer to the metrics.
+ * @param kind The kind of the action.
+ * @param exec_at The time the action was due, in wall-clock milliseconds.
+ */
+void metrics_fired(metrics_t *m, act_kind_t kind, uint64_t exec_at);
+/**
+ * @brief Records the time spent handling one wake-up of the game loop.
+ * @param m Pointer to the metrics.
+ * @param us The duration in microseconds.
+ */
+void metrics_loop(metrics_t *m, uint64_t us);
+/**
+ * @brief Records the scheduler's queue length after a change.
+ * @param m Pointer to the metrics.
+ * @param len The number of pending actions.
+ */
+void metrics_sched_len(metrics_t *m, int len);
+/**
+ * @brief Gives a player slot to a new connection, resetting its counters.
+ * @param m Pointer to the metrics.
+ * @param id The connection's player ID.
+ */
+void metrics_client_open(metrics_t *m, uint32_t id);
+/**
+ * @brief Marks a player slot as free.
+ * @param m Pointer to the metrics.
+ * @param id The player ID of the closed connection.
+ */
+void metrics_client_close(metrics_t *m, uint32_t id);
+/**
+ * @brief Accounts for I/O system calls made for a connection.
+ * @param m Pointer to the metrics.
+ * @param id The connection's player ID.
+ * @param dir MIO_BYTES_IN for reads, MIO_BYTES_OUT for writes.
+ * @param io The bytes moved and calls made.
+ */
+void metrics_client_io(metrics_t *m, uint32_t id, metric_io_t dir,
+    const io_count_t *io);
+/**
+ * @brief Appends every metric in the Prometheus text exposition format.
+ * @param m Pointer to the metrics.
+ * @param ob The buffer receiving the text.
+ * @return True on success, false if the buffer could not grow.
+ */
+bool metrics_render(const metrics_t *m, outbuf_t *ob);
+
+#endif /* METRICS_H */
@@ -29,6 +29,14 @@ void drop_fd(net_t *net, int idx);
  * @note It is typically called in a loop to continuously handle client interactions.
  */
 void handle_client(net_t *net, int idx);
+/**
+ * @brief Processes bytes received from a client.
+ * @param net Pointer to the network structure containing the game state.
+ * @param idx The index of the client.
+ * @param buf The bytes, the team name first, then commands.
+ * @param r The number of bytes.
+ */
+void net_client_input(net_t *net, int idx, const char *buf, ssize_t r);
 /**
  * @brief Handles a client disconnection.
  * @param net Pointer to the network structure containing the game state.
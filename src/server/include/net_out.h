@@ -0,0 +1,124 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** net_out
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef NET_OUT_H
+    #define NET_OUT_H
+    #define OUTBUF_MIN_CAP 1024
+
+/**
+ * @brief Growable outbound byte queue attached to a client connection.
+ * @param data The queued bytes (only [off, len) is still pending).
+ * @param off Offset of the first byte not yet written to the socket.
+ * @param len Number of bytes stored in data.
+ * @param cap Allocated capacity of data.
+ * @param mid_line Set when the bytes written so far end inside a line.
+ * @note Bytes are appended at the end and drained from the front by
+ * @note outbuf_flush, so a slow peer never loses part of a message.
+ */
+typedef struct s_outbuf {
+    char *data;
+    size_t off;
+    size_t len;
+    size_t cap;
+    bool mid_line;
+} outbuf_t;
+
+/**
+ * @brief Bytes moved by a series of I/O system calls.
+ * @param bytes The number of bytes transferred.
+ * @param calls The number of system calls made, successful or not.
+ */
+typedef struct s_io_count {
+    uint64_t bytes;
+    uint64_t calls;
+} io_count_t;
+
+/**
+ * @brief Length-prefixed literal, appended with a single memcpy.
+ * @param str The bytes.
+ * @param len The number of bytes, computed once at compile time.
+ */
+typedef struct s_token {
+    const char *str;
+    size_t len;
+} token_t;
+
+    #define TOKEN(lit) {(lit), sizeof(lit) - 1}
+
+/**
+ * @brief Returns the number of bytes still waiting to be written.
+ * @param ob Pointer to the outbound queue.
+ * @return The pending byte count.
+ */
+static inline size_t outbuf_pending(const outbuf_t *ob)
+{
+    return ob->len - ob->off;
+}
+
+/**
+ * @brief Preallocates the queue storage.
+ * @param ob Pointer to the outbound queue, zeroed.
+ * @param cap The initial capacity.
+ * @return True on success, false if the allocation failed.
+ */
+bool outbuf_init(outbuf_t *ob, size_t cap);
+/**
+ * @brief Makes room for n more bytes after data + len.
+ * @param ob Pointer to the outbound queue.
+ * @param n The number of bytes the caller is about to write.
+ * @return True on success, false if the queue could not grow.
+ * @note May compact the queue: offsets into data are invalidated, only
+ * @note outbuf_pending() stays meaningful across the call.
+ */
+bool outbuf_reserve(outbuf_t *ob, size_t n);
+/**
+ * @brief Appends bytes at the end of the queue, growing it when needed.
+ * @param ob Pointer to the outbound queue.
+ * @param msg The bytes to append.
+ * @param n The number of bytes to append.
+ * @return True on success, false if the queue could not grow.
+ */
+bool outbuf_append(outbuf_t *ob, const char *msg, size_t n);
+/**
+ * @brief Appends the decimal representation of an unsigned number.
+ * @param ob Pointer to the outbound queue.
+ * @param v The value to format.
+ * @return True on success, false if the queue could not grow.
+ */
+bool outbuf_append_uint(outbuf_t *ob, unsigned long long v);
+/**
+ * @brief Writes as much of the pending bytes as the socket accepts.
+ * @param ob Pointer to the outbound queue.
+ * @param fd The socket to write to (non-blocking).
+ * @param io Accumulates the bytes written and write calls made, may be NULL.
+ * @return False on a fatal socket error, true otherwise (including EAGAIN).
+ */
+bool outbuf_flush(outbuf_t *ob, int fd, io_count_t *io);
+/**
+ * @brief Discards every pending message except the one being written.
+ * @param ob Pointer to the outbound queue.
+ * @note If a line was partially sent, its tail is kept so the peer never
+ * @note receives a truncated protocol line.
+ */
+void outbuf_drop_pending(outbuf_t *ob);
+/**
+ * @brief Empties the queue so its storage can serve another connection.
+ * @param ob Pointer to the outbound queue.
+ * @param keep Storage larger than this is released instead of kept.
+ */
+void outbuf_recycle(outbuf_t *ob, size_t keep);
+/**
+ * @brief Releases the memory held by the queue.
+ * @param ob Pointer to the outbound queue.
+ */
+void outbuf_free(outbuf_t *ob);
+
+#endif /* NET_OUT_H */
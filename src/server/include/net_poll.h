@@ -11,41 +11,75 @@
 #include "world.h"
 #include "team.h"
 #include "egg.h"
+#include "player.h"
+#include "acceptor.h"
+#include "direction.h"
+#include "metrics.h"
+#include "admin.h"
+#include "ritual.h"
 
 #ifndef NET_POLL_H
     #define NET_POLL_H
     #define NET_MAX_FDS 128
+    #define NET_TICK_ARENA (64 * 1024)
+
+struct s_gui_ring;
+struct s_trace;
 
 /**
  * @brief Structure representing the network state.
- * @param listen_fd The file descriptor for the listening socket.
+ * @param listen_fd The file descriptor for the TCP listening socket.
+ * @param nlisten The number of listening sockets, they occupy the first pfds slots.
+ * @param unix_path The filesystem path of the AF_UNIX listener, or NULL.
+ * @param ring The shared-memory GUI feed, or NULL.
  * @param pfds Array of poll file descriptors for managing client connections.
  * @param players Array of pointers to player structures associated with each file descriptor.
+ * @param pool The preallocated players handed out to new connections.
+ * @param acceptors The SO_REUSEPORT accepting threads, when started with -r.
  * @param nfds The number of file descriptors currently being monitored.
  * @param sched Pointer to the scheduler managing game actions.
  * @param freq The frequency of the scheduler.
  * @param world Pointer to the world structure containing the game state.
  * @param teams Array of team structures representing the teams in the game.
  * @param team_cnt The number of teams in the game.
- * @param eggs Array of egg structures representing the eggs in the game.
- * @param egg_count The current count of eggs in the game.
- * @param next_egg_id The ID to be assigned to the next egg created.
+ * @param team_index The perfect hash table from team name to team index.
+ * @param eggs The eggs laid on the map, indexed by team and by tile.
+ * @param bcast Scratch receivers of the broadcast being delivered.
+ * @param metrics The health counters, also fed by the scheduler.
+ * @param admin The metrics endpoint, when started with -a.
+ * @param woke_us When the last poll returned, to time the loop iteration.
+ * @param trace The trace replayed with -t, which takes every client's
+ *        output instead of a socket, or NULL.
+ * @param tick Scratch memory for the current loop iteration, reset once
+ *        every client's output was flushed.
+ * @param rituals The incantations in progress.
  * @note This structure encapsulates the network state, including client connections, game scheduling, and the game world.
  * @note It is used to manage player connections, team assignments, and egg management.
  */
 typedef struct s_net {
     int listen_fd;
+    int nlisten;
+    const char *unix_path;
+    struct s_gui_ring *ring;
     struct pollfd pfds[NET_MAX_FDS + 1];
     void *players[NET_MAX_FDS + 1];
+    player_pool_t pool;
+    acceptor_pool_t acceptors;
     int nfds;
     scheduler_t *sched;
     int freq;
     struct s_world *world;
     team_t *teams;
     int team_cnt;
-    egg_t eggs[EGG_MAX];
-    int egg_count;
-    int next_egg_id;
+    team_table_t team_index;
+    egg_pool_t eggs;
+    dir_batch_t bcast;
+    metrics_t metrics;
+    admin_t admin;
+    uint64_t woke_us;
+    struct s_trace *trace;
+    arena_t tick;
+    ritual_pool_t rituals;
 } net_t;
 
 /**
@@ -56,6 +90,11 @@ typedef struct s_net {
  * @param team_cnt The number of teams in the game.
  * @param sched Pointer to the scheduler managing game actions.
  * @param freq The frequency of the scheduler.
+ * @param unix_path Path of an optional AF_UNIX listener, or NULL.
+ * @param shm_name Name of an optional shared-memory GUI feed, or NULL.
+ * @param acceptors Number of SO_REUSEPORT accepting threads, 0 to accept inline.
+ * @param admin Port or Unix socket path of the metrics endpoint, or NULL.
+ * @param offline Set to open no listening socket, when replaying a trace.
  * @note This structure is used to pass parameters during network initialization, allowing for flexible configuration of the server.
  */
 typedef struct s_net_params {
@@ -65,6 +104,11 @@ typedef struct s_net_params {
     int team_cnt;
     scheduler_t *sched;
     int freq;
+    const char *unix_path;
+    const char *shm_name;
+    int acceptors;
+    const char *admin;
+    bool offline;
 } net_params_t;
 
 /**
@@ -83,6 +127,26 @@ bool net_init(net_t *net, const net_params_t *p);
  * @note This function checks for incoming data on client connections and processes any events that occur.
  */
 void net_poll_once(net_t *net, int timeout_ms);
+/**
+ * @brief Writes every client's pending output.
+ * @param net Pointer to the net_t structure representing the network state.
+ * @note Called once per loop iteration, after the due actions ran: a client
+ * @note hearing many broadcasts in one tick receives them in one write.
+ */
+void net_flush_all(net_t *net);
+/**
+ * @brief Registers a new client connection.
+ * @param net Pointer to the net_t structure representing the network state.
+ * @param fd The client's socket, or -1 for a replayed client.
+ * @return The client's player, or NULL if the server is full, in which
+ *         case fd is closed without a WELCOME.
+ */
+player_t *net_add_client(net_t *net, int fd);
+/**
+ * @brief Drops the clients marked doomed since the last call.
+ * @param net Pointer to the net_t structure representing the network state.
+ */
+void net_drop_doomed(net_t *net);
 /**
  * @brief Handles network events.
  * @param net Pointer to the net_t structure representing the network state.
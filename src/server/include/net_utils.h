@@ -28,5 +28,25 @@ bool set_nonblock(int fd);
  * * @note If any step fails (socket creation, binding, or listening), it returns false.
  */
 bool setup_listen_socket(net_t *net, int port);
+/**
+ * * @brief Sets up a blocking TCP listener sharing its port via SO_REUSEPORT.
+ * * @param port The port number to listen on.
+ * * @return The listening descriptor, or -1 on failure.
+ * * @note Every acceptor thread owns one; the kernel spreads connections.
+ */
+int setup_reuseport_socket(int port);
+/**
+ * * @brief Sets up a listening AF_UNIX stream socket for co-located clients.
+ * * @param path The filesystem path to bind, a stale socket file is replaced.
+ * * @return The non-blocking listening descriptor, or -1 on failure.
+ * * @note Clients on the same host skip the TCP/IP stack entirely.
+ */
+int setup_unix_listen_socket(const char *path);
+/**
+ * * @brief Sets up a TCP listener reachable from the local host only.
+ * * @param port The port number to listen on, bound to 127.0.0.1.
+ * * @return The non-blocking listening descriptor, or -1 on failure.
+ */
+int setup_loopback_listen_socket(int port);
 
 #endif /* NET_UTILS_H */
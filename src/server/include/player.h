@@ -9,73 +9,180 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "world.h"
+#include "net_out.h"
 
 #ifndef PLAYER_H
     #define PLAYER_H
     #define PLAYER_BUF_SZ 1024
     #define PLAYER_QUEUE_MAX 10
+    #define PLAYER_OUT_KEEP (64 * 1024)
+    #define PLAYER_SLOT_BITS 16
+    #define PLAYER_GEN_MASK 0x7fffU
+    #define PLAYER_ID(gen, slot) (((uint32_t)(gen) << PLAYER_SLOT_BITS) | \
+        (uint32_t)(slot))
+    #define PLAYER_SLOT(id) ((id) & ((1U << PLAYER_SLOT_BITS) - 1))
 
 struct s_scheduler;
 struct s_world;
 struct s_net;
+struct s_ritual;
 
 /**
- * @brief Structure representing a player in the game.
- * @param fd The file descriptor for the player's socket connection.
+ * @brief Cold per-connection input state, kept out of player_t.
  * @param buf The buffer for incoming data from the player.
  * @param len The length of the data in the buffer.
  * @param queue The queue of commands for the player.
- * @param q_len The length of the command queue.
+ * @note Only touched when the socket is readable, so the 1 KB buffer no
+ * @note longer sits between the fields game logic scans every tick.
+ */
+typedef struct s_player_io {
+    char buf[PLAYER_BUF_SZ];
+    size_t len;
+    char *queue[PLAYER_QUEUE_MAX];
+} player_io_t;
+
+/**
+ * @brief Structure representing a player in the game.
+ * @param id The stable generational ID shown to GUIs (see PLAYER_ID).
  * @param x The X coordinate of the player's position on the map.
  * @param y The Y coordinate of the player's position on the map.
  * @param dir The direction the player is facing (0-3).
  * @param level The player's current level.
- * @param world Pointer to the world structure containing the game state.
- * @param net Pointer to the network structure managing client connections.
- * @param authed Indicates whether the player has been authenticated.
  * @param team_idx The index of the team the player belongs to.
+ * @param authed Indicates whether the player has been authenticated.
+ * @param doomed Set when the connection must be dropped at the next safe point.
+ * @param resync_pending Set while a GUI resync snapshot is still queued.
+ * @param q_len The length of the command queue.
  * @param inv The player's inventory, represented as an array of resource counts.
+ * @param fd The file descriptor for the player's socket connection.
  * @param freq The frequency of the player's actions in the game.
  * @param next_food The timestamp for the next food consumption check.
- * @note This structure encapsulates all the necessary information about a player, including their connection details, position, direction, level, team affiliation, inventory, and game state management.
+ * @param world Pointer to the world structure containing the game state.
+ * @param net Pointer to the network structure managing client connections.
+ * @param out The queue of bytes not yet accepted by the player's socket.
+ * @param io The cold input state of the connection.
+ * @param ritual The incantation the player is frozen into, or NULL.
+ * @param ritual_next The next participant of that incantation.
+ * @note Fields read by every per-tick scan come first and share a cache line.
  * @note It is used to manage player interactions, movements, and actions within the game world.
  */
 typedef struct s_player {
-    int fd;
-    char buf[PLAYER_BUF_SZ];
-    size_t len;
-    char *queue[PLAYER_QUEUE_MAX];
-    int q_len;
+    uint32_t id;
     int x;
     int y;
     int dir;
     int level;
-    struct s_world *world;
-    struct s_net *net;
-    bool authed;
     int team_idx;
+    bool authed;
+    bool doomed;
+    bool resync_pending;
+    int q_len;
     uint16_t inv[RES_MAX];
+    int fd;
     int freq;
     uint64_t next_food;
+    struct s_world *world;
+    struct s_net *net;
+    outbuf_t out;
+    player_io_t *io;
+    struct s_ritual *ritual;
+    struct s_player *ritual_next;
 } player_t;
 
+/**
+ * @brief Preallocated slab of players, recycled across connections.
+ * @param slab The player objects, allocated once at startup.
+ * @param io The cold input state of each slot, same indexing as slab.
+ * @param free Stack of the slots currently unused.
+ * @param free_cnt The number of entries in the free stack.
+ * @param cap The number of slots in the slab.
+ * @note Each slot keeps its output queue storage between connections, so a
+ * @note connection storm neither allocates nor frees memory.
+ */
+typedef struct s_player_pool {
+    player_t *slab;
+    player_io_t *io;
+    player_t **free;
+    int free_cnt;
+    int cap;
+} player_pool_t;
+
+/**
+ * @brief Allocates the slab and the output queue of every slot.
+ * @param pool Pointer to the pool to initialize.
+ * @param cap The number of players the pool can hand out.
+ * @return True on success, false if an allocation failed.
+ */
+bool player_pool_init(player_pool_t *pool, int cap);
+/**
+ * @brief Releases the slab and every output queue.
+ * @param pool Pointer to the pool.
+ */
+void player_pool_destroy(player_pool_t *pool);
+
+/**
+ * @brief Finds the connected player holding an ID.
+ * @param pool The pool the player was taken from.
+ * @param id The ID, as sent to GUIs.
+ * @return The player, or NULL if it disconnected since.
+ * @note The slot is in the low bits, the slot's generation above: an ID is
+ * @note never reused by the next connection landing in the same slot.
+ */
+player_t *player_by_id(player_pool_t *pool, uint32_t id);
+/**
+ * @brief Checks that a slot still holds the connection an ID was taken from.
+ * @param p The slot, as remembered by a deferred action.
+ * @param id The ID the slot held when the action was scheduled.
+ * @return The player, or NULL if it disconnected since.
+ * @note A remembered pointer alone cannot tell: the slot may already have
+ * @note been handed to the next connection.
+ */
+player_t *player_alive(player_t *p, uint32_t id);
 /**
  * @brief Creates a new player instance.
+ * @param pool The pool the player is taken from.
  * @param fd The file descriptor for the player's socket connection.
- * @param world Pointer to the world structure containing the game state.
- * @param freq The frequency of the player's actions in the game.
  * @param net Pointer to the network structure managing client connections.
- * @return A pointer to the newly created player instance, or NULL on failure.
+ * @return A pointer to the player, or NULL when the pool is exhausted.
  * @note This function initializes a player with default values and prepares them for interaction within the game world.
  */
-player_t *player_create(int fd, struct s_world *world,
-    int freq, struct s_net *net);
+player_t *player_create(player_pool_t *pool, int fd, struct s_net *net);
 /**
- * @brief Destroys a player instance and frees associated resources.
+ * @brief Closes a player's connection and returns it to its pool.
+ * @param pool The pool the player was taken from.
  * @param p Pointer to the player instance to be destroyed.
  * @note This function cleans up the player's resources, including their command queue and network connection.
  */
-void player_destroy(player_t *p);
+void player_destroy(player_pool_t *pool, player_t *p);
+/**
+ * @brief Puts a freshly authenticated player on its tile's occupant count.
+ * @param p Pointer to the player, at its spawn position.
+ */
+void player_place(player_t *p);
+/**
+ * @brief Moves a player, keeping the tiles' occupant counts up to date.
+ * @param p Pointer to the player.
+ * @param x The new X coordinate, already wrapped.
+ * @param y The new Y coordinate, already wrapped.
+ */
+void player_move(player_t *p, int x, int y);
+/**
+ * @brief Queues a reply for the player.
+ * @param p Pointer to the player instance.
+ * @param msg The bytes to send.
+ * @param n The number of bytes.
+ * @note Nothing is written here: net_flush_all sends every queue once per
+ * @note loop iteration, so replies produced in the same tick share a syscall.
+ * @note Dropped if the connection is already closed.
+ */
+void player_send(player_t *p, const char *msg, size_t n);
+/**
+ * @brief Sends whatever the player's output queue holds.
+ * @param p Pointer to the player instance.
+ * @note Only needed before dropping a connection, the loop flushes the rest.
+ * @note A fatal socket error dooms the connection instead of closing it here.
+ */
+void player_flush(player_t *p);
 
 /**
  * @brief Feeds data to a player, processing it and executing commands.
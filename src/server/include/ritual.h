@@ -0,0 +1,102 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ritual - registry of the incantations in progress
+*/
+
+#include <stdint.h>
+#include "player.h"
+
+#ifndef RITUAL_H
+    #define RITUAL_H
+    #define RITUAL_MAX 128
+
+struct s_net;
+
+/**
+ * @brief An incantation in progress and the players frozen into it.
+ * @param net The network state, for the action resolving the ritual.
+ * @param x The X coordinate of the ritual's tile.
+ * @param y The Y coordinate of the ritual's tile.
+ * @param level The level the participants had when it started.
+ * @param initiator The ID of the player who started it.
+ * @param first The first participant, the others follow ritual_next.
+ * @param count The number of participants.
+ * @note The participant set is fixed when the ritual starts. A player takes
+ * @note part in at most one ritual, and leaves it only by disconnecting.
+ */
+typedef struct s_ritual {
+    struct s_net *net;
+    int x;
+    int y;
+    int level;
+    uint32_t initiator;
+    player_t *first;
+    int count;
+} ritual_t;
+
+/**
+ * @brief Preallocated rituals; each needs a distinct player, so RITUAL_MAX
+ *        slots are enough for every player to start one.
+ * @param slots The rituals.
+ * @param free Stack of the slots currently unused.
+ * @param free_cnt The number of entries in the free stack.
+ */
+typedef struct s_ritual_pool {
+    ritual_t slots[RITUAL_MAX];
+    ritual_t *free[RITUAL_MAX];
+    int free_cnt;
+} ritual_pool_t;
+
+/**
+ * @brief Marks every ritual slot free.
+ * @param pool The registry.
+ */
+void ritual_pool_init(ritual_pool_t *pool);
+/**
+ * @brief Starts a ritual on the initiator's tile, with no participant yet.
+ * @param pool The registry.
+ * @param init The player starting it.
+ * @return The ritual, or NULL if every slot is taken.
+ */
+ritual_t *ritual_open(ritual_pool_t *pool, const player_t *init);
+/**
+ * @brief Freezes a player into a ritual, in front of its participants.
+ * @param r The ritual.
+ * @param p A player in no ritual.
+ */
+void ritual_join(ritual_t *r, player_t *p);
+/**
+ * @brief Removes a disconnecting player from its ritual, if any.
+ * @param p The player.
+ */
+void ritual_leave(player_t *p);
+/**
+ * @brief Releases every participant and gives the slot back.
+ * @param pool The registry.
+ * @param r The ritual.
+ */
+void ritual_close(ritual_pool_t *pool, ritual_t *r);
+/**
+ * @brief Finds a participant by ID.
+ * @param r The ritual.
+ * @param id The player's ID.
+ * @return The participant, or NULL if it disconnected.
+ */
+player_t *ritual_member(const ritual_t *r, uint32_t id);
+/**
+ * @brief Tells whether a participant still stands where the ritual started.
+ * @param r The ritual.
+ * @param p The participant.
+ * @return True if it is on the ritual's tile, at the ritual's level.
+ */
+bool ritual_in_place(const ritual_t *r, const player_t *p);
+/**
+ * @brief Counts the participants still in place.
+ * @param r The ritual.
+ * @return The number of participants for which ritual_in_place holds.
+ */
+int ritual_in_place_count(const ritual_t *r);
+
+#endif /* RITUAL_H */
@@ -0,0 +1,66 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** rng
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef RNG_H
+    #define RNG_H
+
+/**
+ * @brief Independent random streams, one per consumer.
+ * @note Each stream is derived from the same seed, so adding draws to one
+ * @note (e.g. more refills) never shifts the sequence of another.
+ */
+typedef enum e_rng_stream {
+    RNG_WORLD,
+    RNG_REFILL,
+    RNG_SPAWN,
+    RNG_STREAMS
+} rng_stream_t;
+
+/**
+ * @brief State of a xoshiro256** generator.
+ * @param s The 256-bit state, never all zero.
+ */
+typedef struct s_rng {
+    uint64_t s[4];
+} rng_t;
+
+/**
+ * @brief Seeds a generator for one stream.
+ * @param r Pointer to the generator.
+ * @param seed The run seed.
+ * @param stream The stream the generator serves.
+ * @note The state is expanded from seed and stream with splitmix64.
+ */
+void rng_seed(rng_t *r, uint64_t seed, rng_stream_t stream);
+/**
+ * @brief Draws 64 random bits.
+ * @param r Pointer to the generator.
+ * @return The next value.
+ */
+uint64_t rng_next(rng_t *r);
+/**
+ * @brief Draws a uniform integer in [0, n).
+ * @param r Pointer to the generator.
+ * @param n The exclusive bound, greater than zero.
+ * @return The value, without modulo bias.
+ * @note Lemire's multiply-shift: a division only happens on the rare
+ * @note rejection path.
+ */
+uint32_t rng_below(rng_t *r, uint32_t n);
+/**
+ * @brief Draws many uniform integers in [0, n).
+ * @param r Pointer to the generator.
+ * @param n The exclusive bound, greater than zero.
+ * @param out The array receiving the values.
+ * @param count The number of values to draw.
+ */
+void rng_fill_below(rng_t *r, uint32_t n, uint32_t *out, size_t count);
+
+#endif /* RNG_H */
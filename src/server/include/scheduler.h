@@ -7,20 +7,47 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "arena.h"
 
 #ifndef SCHEDULER_H
     #define SCHEDULER_H
     #define SCHED_MAX 1024
+    #define SCHED_CTX_SZ 64
+    #define SCHED_TEXT_SZ 1024
 
 struct s_player;
+struct s_metrics;
 
 typedef void (*cmd_fn_t)(struct s_player *);
 
+/**
+ * @brief What a scheduled action does, for the metrics.
+ * @note ACT_INTERNAL, the zero value, covers server timers such as the
+ * @note periodic refill.
+ */
+typedef enum e_act_kind {
+    ACT_INTERNAL,
+    ACT_FORWARD,
+    ACT_RIGHT,
+    ACT_LEFT,
+    ACT_LOOK,
+    ACT_INVENTORY,
+    ACT_BROADCAST,
+    ACT_CONNECT_NBR,
+    ACT_FORK,
+    ACT_EJECT,
+    ACT_TAKE,
+    ACT_SET,
+    ACT_INCANTATION,
+    ACT_KINDS
+} act_kind_t;
+
 /**
  * @brief Structure representing an action in the scheduler.
  * @param exec_at The timestamp when the action should be executed.
  * @param fn The function to be executed for this action.
  * @param pl Pointer to the player associated with this action.
+ * @param kind The command the action carries out.
  * @note This structure encapsulates the details of an action that is scheduled to be executed at a specific time.
  * @note It includes the execution time, the function to call, and the player involved in the action.
  */
@@ -28,18 +55,27 @@ typedef struct s_action {
     uint64_t exec_at;
     cmd_fn_t fn;
     struct s_player *pl;
+    act_kind_t kind;
 } action_t;
 
 /**
  * @brief Structure representing a scheduler that manages actions.
  * @param items An array of actions to be scheduled.
  * @param len The current number of actions in the scheduler.
+ * @param metrics Where queue length, failures and fired actions are
+ *        counted, or NULL.
+ * @param ctx Blocks of SCHED_CTX_SZ bytes for the context of an action,
+ *        freed by the action when it fires.
+ * @param text Blocks of SCHED_TEXT_SZ bytes for text an action carries.
  * @note This structure is used to manage a collection of actions that need to be executed at specific times.
  * @note It provides functionality to add, remove, and execute actions based on their scheduled time.
  */
 typedef struct s_scheduler {
     action_t items[SCHED_MAX];
     int len;
+    struct s_metrics *metrics;
+    slab_t ctx;
+    slab_t text;
 } scheduler_t;
 
 /**
@@ -47,6 +83,7 @@ typedef struct s_scheduler {
  * @param name The name of the command.
  * @param fn The function to be executed for this command.
  * @param cost The cost associated with executing this command.
+ * @param kind The kind given to the scheduled action.
  * @note This structure is used to map command names to their corresponding functions and execution costs.
  * @note It allows the scheduler to efficiently look up and execute commands based on user input.
  */
@@ -54,14 +91,27 @@ typedef struct s_cmd_map {
     const char *name;
     cmd_fn_t fn;
     int cost;
+    act_kind_t kind;
 } cmd_map_t;
 
+/**
+ * @brief Names an action kind.
+ * @param kind The kind.
+ * @return The protocol command name, or "internal".
+ */
+const char *act_kind_name(act_kind_t kind);
 /**
  * @brief Initializes a scheduler instance.
  * @param s Pointer to the scheduler instance to be initialized.
  * @note This function sets up the scheduler by clearing its action list and preparing it for use.
  */
 void scheduler_init(scheduler_t *s);
+/**
+ * @brief Releases the slabs, and with them the context of every pending
+ *        action.
+ * @param s Pointer to the scheduler instance.
+ */
+void scheduler_destroy(scheduler_t *s);
 /**
  * @brief Push a scheduler instance.
  * @param s Pointer to the scheduler instance to be destroyed.
@@ -95,6 +145,18 @@ void scheduler_remove_player_actions(scheduler_t *s, struct s_player *pl);
 bool sched_cmd_from_string(struct s_player *pl, const char *line,
     scheduler_t *s, int freq);
 
+/**
+ * @brief Scales the time left before every pending action.
+ * @param s Pointer to the scheduler instance.
+ * @param now The current timestamp in milliseconds.
+ * @param num The multiplier of the time left.
+ * @param den The divisor of the time left.
+ * @note The mapping never reorders two actions, so the heap stays valid
+ * @note and the pass is linear.
+ */
+void scheduler_rescale(scheduler_t *s, uint64_t now, uint64_t num,
+    uint64_t den);
+
 /* Return the number of milliseconds until the next action is due.
  * If the scheduler is empty, UINT64_MAX is returned. */
 /**
@@ -6,6 +6,8 @@
 */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifndef TEAM_H
     #define TEAM_H
@@ -13,15 +15,32 @@
 /**
  * @brief Structure representing a team in the game.
  * @param name The name of the team.
+ * @param name_len The length of the name, computed once at startup.
  * @param slots The number of available slots for players in the team.
  * @note This structure is used to manage teams within the game, allowing for team identification and
  *       tracking of available player slots.
  */
 typedef struct s_team {
     char *name;
+    size_t name_len;
     int slots;
 } team_t;
 
+/**
+ * @brief Collision-free hash table from team name to team index.
+ * @param slots The team index stored in each bucket, or -1.
+ * @param mask The bucket count minus one, the count being a power of two.
+ * @param seed The hash seed for which no two team names share a bucket.
+ * @note The team names are fixed at startup, so the table is searched for
+ * @note a seed that makes it perfect: a lookup hashes the name once and
+ * @note compares it against a single candidate.
+ */
+typedef struct s_team_table {
+    int *slots;
+    uint32_t mask;
+    uint32_t seed;
+} team_table_t;
+
 /**
  * @brief Initializes an array of teams.
  * @param arr Pointer to the array of team structures.
@@ -32,23 +51,36 @@ typedef struct s_team {
  */
 void teams_init(team_t *arr, int count, char **names, int slots);
 /**
- * @brief Finds a team by its name in the array of teams.
+ * @brief Builds the perfect hash table over the team names.
+ * @param table Pointer to the table to build.
  * @param arr Pointer to the array of team structures.
  * @param count The number of teams in the array.
+ * @return True on success, false if an allocation failed.
+ * @note A name given twice resolves to its first team, as before.
+ */
+bool team_table_build(team_table_t *table, const team_t *arr, int count);
+/**
+ * @brief Releases the table's memory.
+ * @param table Pointer to the table.
+ */
+void team_table_destroy(team_table_t *table);
+/**
+ * @brief Finds a team by its name.
+ * @param table Pointer to the table built over arr.
+ * @param arr Pointer to the array of team structures.
  * @param name The name of the team to find.
  * @return The index of the team if found, or -1 if not found.
- * @note This function is used to locate a specific team based on its name, allowing for operations on that team.
  */
-int team_find(team_t *arr, int count, const char *name);
+int team_find(const team_table_t *table, const team_t *arr,
+    const char *name);
 /**
  * @brief Attempts to take a slot in a team for a new player.
  * @param arr Pointer to the array of team structures.
- * @param count The number of teams in the array.
- * @param name The name of the team to take a slot in.
+ * @param idx The index of the team, as returned by team_find.
  * @param remaining Pointer to an integer that will hold the number of remaining slots after taking one.
  * @return True if a slot was successfully taken, false if no slots are available.
  */
-bool team_take_slot(team_t *arr, int count, const char *name, int *remaining);
+bool team_take_slot(team_t *arr, int idx, int *remaining);
 /**
  * @brief Releases a slot in a team, making it available for new players.
  * @param arr Pointer to the array of team structures.
@@ -0,0 +1,28 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** timescale - live change of the time unit
+*/
+
+#include <stdbool.h>
+#include "net_poll.h"
+
+#ifndef TIMESCALE_H
+    #define TIMESCALE_H
+
+    /* Resources respawn every 20 time units, i.e. 20000 / freq ms: any
+     * faster and that period rounds to 0 and the refill never sleeps. */
+    #define TIMESCALE_MAX_FREQ 20000
+
+/**
+ * @brief Changes the frequency of a running match.
+ * @param net Pointer to the network structure containing the game state.
+ * @param freq The new frequency, in time units per second.
+ * @return False if freq is not in 1..TIMESCALE_MAX_FREQ.
+ * @note Pending actions and meals keep the number of time units they had
+ * @note left: their remaining milliseconds are scaled by old / new freq.
+ */
+bool timescale_set(net_t *net, int freq);
+
+#endif /* TIMESCALE_H */
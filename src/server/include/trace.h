@@ -0,0 +1,115 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** trace - deterministic replay of recorded client input
+*/
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "net_poll.h"
+
+#ifndef TRACE_H
+    #define TRACE_H
+    #define TRACE_MAX_CLIENTS 4096
+
+/**
+ * @brief What a trace event does to its client.
+ */
+typedef enum e_trace_op {
+    TRACE_CONNECT,
+    TRACE_SEND,
+    TRACE_CLOSE
+} trace_op_t;
+
+/**
+ * @brief One line of the trace: "<ms> <client> connect|send <text>|close".
+ * @param at The game time of the event, in milliseconds from the start.
+ * @param client The trace's number for the client.
+ * @param op What happens.
+ * @param text The line sent, without its newline, for TRACE_SEND.
+ * @param len The length of text.
+ */
+typedef struct s_trace_event {
+    uint64_t at;
+    int client;
+    trace_op_t op;
+    const char *text;
+    size_t len;
+} trace_event_t;
+
+/**
+ * @brief A trace being replayed, and where the clients' output goes.
+ * @param in The trace file.
+ * @param out Receives "<ms> <client> <line>" for every line sent to a
+ *        client, in the order the server sends them.
+ * @param line The last line read from in, which next points into.
+ * @param cap The capacity of line.
+ * @param lineno The number of lines read, for error messages.
+ * @param next The next event to apply, valid while pending is set.
+ * @param pending Set while next holds an event.
+ * @param failed Set on a malformed event or a write error.
+ * @param player_of The ID of each client's player, 0 when not connected.
+ * @param client_of The client of each player slot.
+ */
+typedef struct s_trace {
+    FILE *in;
+    FILE *out;
+    char *line;
+    size_t cap;
+    size_t lineno;
+    trace_event_t next;
+    bool pending;
+    bool failed;
+    uint32_t player_of[TRACE_MAX_CLIENTS];
+    int client_of[NET_MAX_FDS];
+} trace_t;
+
+/**
+ * @brief Opens a trace and reads its first event.
+ * @param path The trace file.
+ * @param out_path Where the clients' output is written, stdout if NULL.
+ * @return The trace, or NULL if a file could not be opened.
+ */
+trace_t *trace_open(const char *path, const char *out_path);
+/**
+ * @brief Flushes the output and closes both files.
+ * @param t The trace, or NULL.
+ */
+void trace_close(trace_t *t);
+/**
+ * @brief Reads the next event of the trace.
+ * @param t The trace.
+ * @note Clears pending at the end of the file, sets failed on a malformed
+ * @note line or on an event earlier than the previous one.
+ */
+void trace_read_next(trace_t *t);
+/**
+ * @brief Applies every event due at a given time.
+ * @param t The trace.
+ * @param net The network the clients connect to.
+ * @param now The current game time in milliseconds.
+ */
+void trace_apply_due(trace_t *t, net_t *net, uint64_t now);
+/**
+ * @brief Writes a client's pending output to the trace output.
+ * @param t The trace.
+ * @param p The client, whose output queue is emptied.
+ * @note Stands in for the socket write of player_flush during a replay.
+ */
+void trace_capture(trace_t *t, player_t *p);
+/**
+ * @brief Replays the whole trace on the virtual clock.
+ * @param t The trace.
+ * @param net The network state, created offline.
+ * @param stop Set by a signal handler to end the replay early.
+ * @return False if the trace was malformed or the output failed.
+ * @note Time jumps straight to the next trace event, due action or meal,
+ * @note so a match runs as fast as the CPU allows, with the same output
+ * @note on every run.
+ */
+bool trace_run(trace_t *t, net_t *net, const volatile sig_atomic_t *stop);
+
+#endif /* TRACE_H */
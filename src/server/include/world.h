@@ -9,9 +9,18 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "cfg.h"
+#include "net_out.h"
+#include "rng.h"
 
 #ifndef WORLD_H
     #define WORLD_H
+    #define WORLD_SCATTER_BATCH 256
+    #define WORLD_CHUNK_SHIFT 4
+    #define WORLD_CHUNK (1 << WORLD_CHUNK_SHIFT)
+    #define WORLD_CHUNK_TILES (WORLD_CHUNK * WORLD_CHUNK)
+    #define WORLD_RES_MAX UINT16_MAX
+
+struct s_journal;
 
 /**
  * @brief Structure representing a tile in the game world.
@@ -34,24 +43,69 @@ typedef enum e_res {
 /**
  * @brief Structure representing the configuration of resources in the game world.
  * @param res An array of resource counts for each type of resource.
+ * @param players The number of players standing on the tile.
+ * @param version Bumped on every change, see tile_touch.
+ * @param egg_head The first egg laid on the tile, or -1.
  * @note This structure is used to define the initial state of resources in the game world.
+ * @note Counts saturate at WORLD_RES_MAX, use tile_res_add and tile_res_take.
  */
 typedef struct s_tile {
     uint16_t res[RES_MAX];
+    uint16_t players;
+    uint32_t version;
+    int egg_head;
 } tile_t;
 
+/**
+ * @brief Serialized Look fragment of a tile ("player food linemate ...").
+ * @param text The fragment, rebuilt when it goes stale.
+ * @param version The tile version the fragment was built from.
+ * @param valid Set once the fragment has been built at least once.
+ * @note A tile's version bumps whenever its resources or occupants change,
+ * @note so crowded Looks over the same area reuse the same bytes.
+ */
+typedef struct s_tile_frag {
+    outbuf_t text;
+    uint32_t version;
+    bool valid;
+} tile_frag_t;
+
+/**
+ * @brief A square block of WORLD_CHUNK x WORLD_CHUNK tiles.
+ * @param tiles The tiles, row-major inside the chunk.
+ * @param frags The cached Look fragment of each tile, same indexing;
+ *        allocated by the first Look that reaches the chunk.
+ */
+typedef struct s_chunk {
+    tile_t tiles[WORLD_CHUNK_TILES];
+    tile_frag_t *frags;
+} chunk_t;
+
 /**
  * @brief Structure representing the game world.
  * @param w The width of the world in tiles.
  * @param h The height of the world in tiles.
- * @param tiles An array of tiles representing the game world.
+ * @param chunks The chunk grid, NULL where nothing was ever written.
+ * @param cols The number of chunk columns.
+ * @param rows The number of chunk rows.
+ * @param totals The number of units of each resource on the whole map.
+ * @param rng One random generator per stream, all derived from the run seed.
+ * @param seed The run seed, recorded by the journal.
+ * @param journal The match journal when started with -j, NULL otherwise.
  * @note This structure encapsulates the entire game world, including its dimensions and the resources available on each tile.
- * @note It is used to manage the state of the game world and facilitate interactions between players and resources.
+ * @note Chunks are allocated on first write, so an empty region of a huge
+ * @note map only costs its pointer in the grid.
  */
 typedef struct s_world {
     int w;
     int h;
-    tile_t *tiles;
+    chunk_t **chunks;
+    size_t cols;
+    size_t rows;
+    uint64_t totals[RES_MAX];
+    rng_t rng[RNG_STREAMS];
+    uint64_t seed;
+    struct s_journal *journal;
 } world_t;
 
 /**
@@ -68,6 +122,17 @@ bool world_create(world_t *w, const cfg_t *cfg);
  * @note This function cleans up the game world, releasing memory and resources associated with it.
  */
 void world_destroy(world_t *w);
+/**
+ * @brief Allocates the empty chunk grid of a world whose size is set.
+ * @param w Pointer to the world structure.
+ * @return True on success, false if the grid cannot be allocated.
+ */
+bool world_chunks_init(world_t *w);
+/**
+ * @brief Frees every allocated chunk and the chunk grid.
+ * @param w Pointer to the world structure.
+ */
+void world_chunks_free(world_t *w);
 /**
  * @brief Respawns the game world, resetting resources and tiles.
  * @param w Pointer to the world structure to be respawned.
@@ -88,6 +153,16 @@ void world_periodic_refill(world_t *w);
  * @note This function is used to convert resource types into human-readable strings for display purposes.
  */
 bool res_from_string(const char *name, res_t *out);
+/**
+ * @brief Drops resources on uniformly drawn tiles.
+ * @param w Pointer to the world structure.
+ * @param stream The random stream the positions are drawn from.
+ * @param id The resource type to drop.
+ * @param count The number of units to drop.
+ * @note Positions are drawn in batches, without modulo bias, so every tile
+ *       of a large map is equally likely.
+ */
+void world_scatter(world_t *w, rng_stream_t stream, res_t id, uint64_t count);
 /**
  * @brief Spawns resources on the game world if needed.
  * @param w Pointer to the world structure where resources will be spawned.
@@ -97,22 +172,100 @@ bool res_from_string(const char *name, res_t *out);
  *       and spawns the required amount if necessary. It is used to manage resource availability in the game.
  * @note The function ensures that resources are available for players to collect and use during gameplay.
  */
-void spawn_resources_if_needed(world_t *w, res_t id, int need);
+void spawn_resources_if_needed(world_t *w, res_t id, int64_t need);
 /**
  * @brief Retrieves a tile from the game world at specified coordinates.
  * @param w Pointer to the world structure.
+ * @param x The x-coordinate of the tile, wrapped around the map.
+ * @param y The y-coordinate of the tile, wrapped around the map.
+ * @return A pointer to the tile at the specified coordinates, or NULL if its chunk cannot be allocated.
+ * @note The tile's chunk is allocated on first access; read-only callers
+ *       should use world_peek_tile so that looking does not grow the map.
+ */
+tile_t *world_get_tile(world_t *w, int x, int y);
+
+/**
+ * @brief Returns the chunk holding a tile, without allocating it.
+ * @param w Pointer to the world structure.
+ * @param x The x-coordinate of the tile, within [0, w->w).
+ * @param y The y-coordinate of the tile, within [0, w->h).
+ * @return The chunk, or NULL if nothing was ever written to it.
+ */
+static inline chunk_t *world_chunk(const world_t *w, int x, int y)
+{
+    return w->chunks[(size_t)(y >> WORLD_CHUNK_SHIFT) * w->cols
+        + (size_t)(x >> WORLD_CHUNK_SHIFT)];
+}
+
+/**
+ * @brief Position of a tile inside its chunk.
  * @param x The x-coordinate of the tile.
  * @param y The y-coordinate of the tile.
- * @return A pointer to the tile at the specified coordinates, or NULL if the coordinates are out of bounds.
- * @note This function allows access to specific tiles in the game world, enabling players and game logic to interact with resources on those tiles.
+ * @return The index into the chunk's tiles and frags.
+ */
+static inline size_t world_chunk_slot(int x, int y)
+{
+    return ((size_t)(y & (WORLD_CHUNK - 1)) << WORLD_CHUNK_SHIFT)
+        | (size_t)(x & (WORLD_CHUNK - 1));
+}
+
+/**
+ * @brief Reads a tile without allocating its chunk.
+ * @param w Pointer to the world structure.
+ * @param x The x-coordinate of the tile, within [0, w->w).
+ * @param y The y-coordinate of the tile, within [0, w->h).
+ * @return The tile, or a shared empty tile if its chunk does not exist.
+ */
+const tile_t *world_peek_tile(const world_t *w, int x, int y);
+
+/**
+ * @brief Marks a tile as changed, invalidating its cached Look fragment.
+ * @param t Pointer to the tile whose resources or occupants changed.
+ */
+static inline void tile_touch(tile_t *t)
+{
+    t->version++;
+}
+
+/**
+ * @brief Drops units of a resource on a tile, saturating at WORLD_RES_MAX.
+ * @param w Pointer to the world, whose totals are kept in sync.
+ * @param t Pointer to the tile.
+ * @param id The resource type.
+ * @param n The number of units to drop.
+ * @return The number of units actually added.
+ */
+static inline unsigned tile_res_add(world_t *w, tile_t *t, res_t id,
+    unsigned n)
+{
+    unsigned room = WORLD_RES_MAX - t->res[id];
+
+    if (n > room)
+        n = room;
+    t->res[id] += (uint16_t)n;
+    w->totals[id] += n;
+    if (n)
+        tile_touch(t);
+    return n;
+}
+
+/**
+ * @brief Removes units of a resource from a tile.
+ * @param w Pointer to the world, whose totals are kept in sync.
+ * @param t Pointer to the tile.
+ * @param id The resource type.
+ * @param n The number of units to remove.
+ * @return True if the tile held at least n units, false if nothing changed.
  */
-static inline tile_t *world_get_tile(world_t *w, int x, int y)
+static inline bool tile_res_take(world_t *w, tile_t *t, res_t id, unsigned n)
 {
-    if (!w || !w->tiles || w->w <= 0 || w->h <= 0)
-        return NULL;
-    x = (x % w->w + w->w) % w->w;
-    y = (y % w->h + w->h) % w->h;
-    return &w->tiles[y * w->w + x];
+    if (t->res[id] < n)
+        return false;
+    t->res[id] -= (uint16_t)n;
+    w->totals[id] -= n;
+    if (n)
+        tile_touch(t);
+    return true;
 }
 
 #endif /* WORLD_H */
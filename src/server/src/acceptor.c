@@ -0,0 +1,107 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** acceptor.c - SO_REUSEPORT accepting threads feeding the game loop
+*/
+
+#define _GNU_SOURCE
+#include "acceptor.h"
+#include "net_utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* The game loop greets the client once it has a player slot for it, so a
+   connection refused because the server is full never sees WELCOME */
+static void hand_off(acceptor_t *acc, int fd)
+{
+    if (write(acc->out, &fd, sizeof(fd)) != (ssize_t)sizeof(fd))
+        close(fd);
+}
+
+static void *acceptor_run(void *arg)
+{
+    acceptor_t *acc = arg;
+    int fd;
+
+    while (atomic_load(acc->running)) {
+        fd = accept4(acc->fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            hand_off(acc, fd);
+            continue;
+        }
+        if (errno != EINTR && errno != ECONNABORTED && errno != EAGAIN)
+            break;
+    }
+    return NULL;
+}
+
+/* Undoes a partial start: the threads already running are stopped and
+   joined before their listeners are closed */
+static bool start_failed(acceptor_pool_t *pool)
+{
+    if (pool->count > 0) {
+        acceptor_pool_stop(pool);
+        return false;
+    }
+    for (int i = 0; i < 2; ++i)
+        if (pool->pipe[i] >= 0)
+            close(pool->pipe[i]);
+    pool->pipe[0] = -1;
+    pool->pipe[1] = -1;
+    return false;
+}
+
+bool acceptor_pool_start(acceptor_pool_t *pool, int port, int count)
+{
+    memset(pool, 0, sizeof(*pool));
+    pool->pipe[0] = -1;
+    pool->pipe[1] = -1;
+    if (count > ACCEPTOR_MAX || pipe2(pool->pipe, O_CLOEXEC) < 0 ||
+        !set_nonblock(pool->pipe[0]))
+        return start_failed(pool);
+    atomic_store(&pool->running, true);
+    for (int i = 0; i < count; ++i) {
+        pool->acc[i] = (acceptor_t){.fd = setup_reuseport_socket(port),
+            .out = pool->pipe[1], .running = &pool->running};
+        if (pool->acc[i].fd < 0)
+            return start_failed(pool);
+        if (pthread_create(&pool->acc[i].thread, NULL, acceptor_run,
+            &pool->acc[i]) != 0) {
+            close(pool->acc[i].fd);
+            return start_failed(pool);
+        }
+        ++pool->count;
+    }
+    return true;
+}
+
+int acceptor_pool_take(acceptor_pool_t *pool, int *fds, int max)
+{
+    ssize_t r = read(pool->pipe[0], fds, (size_t)max * sizeof(*fds));
+
+    return r > 0 ? (int)(r / (ssize_t)sizeof(*fds)) : 0;
+}
+
+/* shutdown() wakes a thread blocked in accept() with EINVAL */
+void acceptor_pool_stop(acceptor_pool_t *pool)
+{
+    int fd;
+
+    if (pool->count == 0)
+        return;
+    atomic_store(&pool->running, false);
+    for (int i = 0; i < pool->count; ++i) {
+        shutdown(pool->acc[i].fd, SHUT_RDWR);
+        pthread_join(pool->acc[i].thread, NULL);
+        close(pool->acc[i].fd);
+    }
+    pool->count = 0;
+    while (acceptor_pool_take(pool, &fd, 1) == 1)
+        close(fd);
+    close(pool->pipe[0]);
+    close(pool->pipe[1]);
+}
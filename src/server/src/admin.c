@@ -0,0 +1,137 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** admin.c - local HTTP endpoint exporting the metrics
+*/
+
+#define _GNU_SOURCE
+#include "admin.h"
+#include "net_utils.h"
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+typedef bool (*admin_render_t)(const metrics_t *, outbuf_t *);
+
+typedef struct s_admin_route {
+    const char *path;
+    admin_render_t render;
+} admin_route_t;
+
+static bool render_drift(const metrics_t *m, outbuf_t *ob)
+{
+    return drift_render(m->drift, ob);
+}
+
+static const admin_route_t ROUTES[] = {
+    {"/metrics", metrics_render},
+    {"/drift", render_drift},
+};
+
+static admin_render_t find_route(const char *req)
+{
+    size_t n;
+
+    if (strncmp(req, "GET ", 4))
+        return NULL;
+    for (size_t i = 0; i < sizeof(ROUTES) / sizeof(*ROUTES); ++i) {
+        n = strlen(ROUTES[i].path);
+        if (!strncmp(req + 4, ROUTES[i].path, n) &&
+            (req[4 + n] == ' ' || req[4 + n] == '?'))
+            return ROUTES[i].render;
+    }
+    return NULL;
+}
+
+static void reply(int fd, const char *status, const outbuf_t *body)
+{
+    char head[160];
+    int n = snprintf(head, sizeof(head), "HTTP/1.0 %s\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+        status, body->len);
+    outbuf_t out = {0};
+
+    if (n > 0 && outbuf_append(&out, head, (size_t)n) &&
+        outbuf_append(&out, body->data, body->len))
+        outbuf_flush(&out, fd, NULL);
+    outbuf_free(&out);
+}
+
+/* Scrapers send the request line at once; a 1 s timeout bounds the rest */
+static void serve(admin_t *admin, int fd)
+{
+    struct timeval tv = {.tv_sec = 1};
+    char req[ADMIN_REQ_MAX];
+    outbuf_t body = {0};
+    admin_render_t render;
+    ssize_t r;
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    r = read(fd, req, sizeof(req) - 1);
+    req[r > 0 ? r : 0] = '\0';
+    render = find_route(req);
+    if (render && render(admin->metrics, &body))
+        reply(fd, "200 OK", &body);
+    else
+        reply(fd, "404 Not Found", &body);
+    outbuf_free(&body);
+    close(fd);
+}
+
+static void *admin_run(void *arg)
+{
+    admin_t *admin = arg;
+    struct pollfd pfd = {.fd = admin->fd, .events = POLLIN};
+    int fd;
+
+    while (atomic_load(&admin->running)) {
+        if (poll(&pfd, 1, ADMIN_POLL_MS) <= 0)
+            continue;
+        fd = accept4(admin->fd, NULL, NULL, SOCK_CLOEXEC);
+        if (fd >= 0)
+            serve(admin, fd);
+    }
+    return NULL;
+}
+
+bool admin_start(admin_t *admin, const char *spec, const metrics_t *metrics)
+{
+    char *end = NULL;
+    long port = strtol(spec, &end, 10);
+
+    memset(admin, 0, sizeof(*admin));
+    admin->metrics = metrics;
+    if (*end == '\0' && port > 0 && port <= 65535) {
+        admin->fd = setup_loopback_listen_socket((int)port);
+    } else {
+        admin->unix_path = spec;
+        admin->fd = setup_unix_listen_socket(spec);
+    }
+    if (admin->fd < 0)
+        return false;
+    atomic_store(&admin->running, true);
+    admin->started = pthread_create(&admin->thread, NULL, admin_run,
+        admin) == 0;
+    if (!admin->started)
+        close(admin->fd);
+    return admin->started;
+}
+
+void admin_stop(admin_t *admin)
+{
+    if (!admin->started)
+        return;
+    atomic_store(&admin->running, false);
+    pthread_join(admin->thread, NULL);
+    close(admin->fd);
+    if (admin->unix_path)
+        unlink(admin->unix_path);
+    admin->started = false;
+}
@@ -0,0 +1,86 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** arena - per-tick bump allocator
+*/
+
+#include "arena.h"
+#include <stdlib.h>
+
+static size_t align_up(size_t n)
+{
+    return (n + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+bool arena_init(arena_t *a, size_t cap)
+{
+    *a = (arena_t){0};
+    a->base = malloc(cap);
+    if (!a->base)
+        return false;
+    a->cap = cap;
+    return true;
+}
+
+static void *arena_spill(arena_t *a, size_t n)
+{
+    arena_spill_t *s = malloc(sizeof(*s) + n);
+
+    if (!s)
+        return NULL;
+    s->next = a->spill;
+    a->spill = s;
+    return s->data;
+}
+
+void *arena_alloc(arena_t *a, size_t n)
+{
+    void *p;
+
+    n = align_up(n ? n : 1);
+    a->need += n;
+    if (a->used + n > a->cap)
+        return arena_spill(a, n);
+    p = a->base + a->used;
+    a->used += n;
+    return p;
+}
+
+/* Grow the block to what the last tick needed, so the next one fits */
+static void arena_grow(arena_t *a)
+{
+    size_t cap = a->cap ? a->cap : ARENA_ALIGN;
+    char *base;
+
+    while (cap < a->need)
+        cap *= 2;
+    base = malloc(cap);
+    if (!base)
+        return;
+    free(a->base);
+    a->base = base;
+    a->cap = cap;
+}
+
+void arena_reset(arena_t *a)
+{
+    arena_spill_t *next;
+
+    for (arena_spill_t *s = a->spill; s; s = next) {
+        next = s->next;
+        free(s);
+    }
+    a->spill = NULL;
+    if (a->need > a->cap)
+        arena_grow(a);
+    a->used = 0;
+    a->need = 0;
+}
+
+void arena_destroy(arena_t *a)
+{
+    arena_reset(a);
+    free(a->base);
+    *a = (arena_t){0};
+}
@@ -6,6 +6,7 @@
 */
 
 #include "cfg.h"
+#include "acceptor.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,6 +42,35 @@ static bool handle_numeric_flag(int *idx, char **av,
     return false;
 }
 
+static bool handle_string_flag(int *idx, char **av,
+    const char *flag, const char **dst)
+{
+    int i = *idx;
+
+    if (!strcmp(av[i], flag) && av[i + 1] && av[i + 1][0]) {
+        *dst = av[i + 1];
+        *idx += 1;
+        return true;
+    }
+    return false;
+}
+
+static bool handle_seed_flag(int *idx, char **av, cfg_t *cfg)
+{
+    int i = *idx;
+    char *end = NULL;
+
+    if (strcmp(av[i], "-s") || !av[i + 1] || !av[i + 1][0] ||
+        av[i + 1][0] == '-')
+        return false;
+    cfg->seed = strtoull(av[i + 1], &end, 10);
+    if (!end || *end)
+        return false;
+    cfg->seeded = true;
+    *idx += 1;
+    return true;
+}
+
 static bool handle_teams_flag(int *idx, int ac, char **av, cfg_t *cfg)
 {
     int i = *idx;
@@ -48,6 +78,7 @@ static bool handle_teams_flag(int *idx, int ac, char **av, cfg_t *cfg)
     if (strcmp(av[i], "-n"))
         return false;
     cfg->teams = &av[i + 1];
+    cfg->team_count = 0;
     while (i + 1 < ac && av[i + 1][0] != '-') {
         ++cfg->team_count;
         ++i;
@@ -63,6 +94,14 @@ static bool handle_flag(int *idx, int ac, char **av, cfg_t *cfg)
         handle_numeric_flag(idx, av, "-y", &cfg->height) ||
         handle_numeric_flag(idx, av, "-c", &cfg->clients_nb) ||
         handle_numeric_flag(idx, av, "-f", &cfg->freq) ||
+        handle_numeric_flag(idx, av, "-r", &cfg->acceptors) ||
+        handle_string_flag(idx, av, "-u", &cfg->unix_path) ||
+        handle_string_flag(idx, av, "-m", &cfg->shm_name) ||
+        handle_string_flag(idx, av, "-a", &cfg->admin) ||
+        handle_string_flag(idx, av, "-j", &cfg->journal) ||
+        handle_string_flag(idx, av, "-t", &cfg->trace) ||
+        handle_string_flag(idx, av, "-o", &cfg->trace_out) ||
+        handle_seed_flag(idx, av, cfg) ||
         handle_teams_flag(idx, ac, av, cfg);
 }
 
@@ -73,8 +112,12 @@ bool cfg_parse(cfg_t *cfg, int ac, char **av)
         if (!handle_flag(&i, ac, av, cfg))
             return false;
     }
-    return cfg->port && cfg->width && cfg->height &&
-        cfg->team_count && cfg->clients_nb && cfg->freq;
+    /* A replay must not depend on when it runs: the seed defaults to 0 */
+    if (cfg->trace)
+        cfg->seeded = true;
+    return (cfg->port || cfg->trace) && cfg->width && cfg->height &&
+        cfg->team_count && cfg->clients_nb && cfg->freq &&
+        cfg->acceptors <= ACCEPTOR_MAX;
 }
 
 void cfg_free(cfg_t *cfg)
@@ -0,0 +1,46 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** clock
+*/
+
+#include "clock.h"
+#include <stddef.h>
+#include <sys/time.h>
+
+/* Process-wide, like the wall clock it stands in for */
+static bool g_virtual = false;
+static uint64_t g_virtual_ms = 0;
+
+uint64_t clock_now_us(void)
+{
+    struct timeval tv;
+
+    if (g_virtual)
+        return g_virtual_ms * 1000ULL;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+uint64_t clock_now_ms(void)
+{
+    return g_virtual ? g_virtual_ms : clock_now_us() / 1000ULL;
+}
+
+void clock_use_virtual(uint64_t start_ms)
+{
+    g_virtual = true;
+    g_virtual_ms = start_ms;
+}
+
+void clock_advance(uint64_t ms)
+{
+    if (ms > g_virtual_ms)
+        g_virtual_ms = ms;
+}
+
+bool clock_is_virtual(void)
+{
+    return g_virtual;
+}
@@ -6,113 +6,95 @@
 */
 
 #include "command_broadcast.h"
+#include "clock.h"
 #include "net_poll.h"
 #include "gui.h"
 #include "command_broadcast_utils.h"
-#include <stdlib.h>
+#include "journal.h"
 #include <string.h>
-#include <stdio.h>
-#include <unistd.h>
-#include <ctype.h>
-#include <sys/time.h>
 
-static uint64_t now_ms(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
+_Static_assert(DIR_BATCH_MAX >= NET_MAX_FDS,
+    "a broadcast must fit every connected player");
+_Static_assert(sizeof(broadcast_ctx_t) <= SCHED_CTX_SZ,
+    "a broadcast context must fit a scheduler slab block");
+_Static_assert(PLAYER_BUF_SZ <= SCHED_TEXT_SZ,
+    "any line a client can send must fit a text slab block");
 
-/* Compute shortest wrapped delta between two coords on an axis */
-static int wrap_delta(int a, int b, int max)
+static bool is_valid_receiver(const player_t *rcv)
 {
-    int d = a - b;
-
-    if (d > max / 2)
-        d -= max;
-    if (d < (-max) / 2)
-        d += max;
-    return d;
+    return rcv && rcv->authed && !IS_GUI(rcv);
 }
 
-/* Return base direction code relative to NORTH-facing receiver (1..8) */
-static int base_dir_from_delta(int dx, int dy)
+static void gather_receivers(net_t *net, dir_batch_t *b)
 {
-    if (dx == 0 && dy == 0)
-        return 0;
-    if (dx == 0)
-        return (dy < 0) ? 1 : 5;
-    if (dy == 0)
-        return (dx > 0) ? 3 : 7;
-    if (dx > 0 && dy < 0)
-        return 2;
-    if (dx > 0 && dy > 0)
-        return 4;
-    if (dx < 0 && dy > 0)
-        return 6;
-    return 8;
-}
+    player_t *rcv;
 
-/* Rotate base direction according to receiver orientation */
-static int apply_orientation(int base, int ori)
-{
-    int shift;
-    int k;
-
-    if (base == 0)
-        return 0;
-    shift = (ori * 2) % 8;
-    k = base - 1;
-    k = (k - shift + 8) % 8;
-    return k + 1;
+    b->count = 0;
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        rcv = (player_t *)net->players[i];
+        if (!is_valid_receiver(rcv))
+            continue;
+        b->who[b->count] = rcv;
+        b->x[b->count] = rcv->x;
+        b->y[b->count] = rcv->y;
+        b->dir[b->count] = rcv->dir;
+        b->count++;
+    }
 }
 
-static int compute_direction(const player_t *emitter, const player_t *receiver)
-{
-    int dx = wrap_delta(emitter->x, receiver->x, receiver->world->w);
-    int dy = wrap_delta(emitter->y, receiver->y, receiver->world->h);
-    int base = base_dir_from_delta(dx, dy);
-
-    return apply_orientation(base, receiver->dir);
-}
+/* "message K, text\n" with the direction digit K at MSG_DIGIT_AT */
+static const token_t MSG_HEAD = TOKEN("message 0, ");
+static const size_t MSG_DIGIT_AT = 8;
 
-static bool is_valid_receiver(const player_t *rcv)
+static char *format_message(arena_t *tick, const char *text, size_t *len)
 {
-    return rcv && rcv->authed && !IS_GUI(rcv);
+    size_t tlen = strlen(text);
+    char *line = arena_alloc(tick, MSG_HEAD.len + tlen + 1);
+
+    if (!line)
+        return NULL;
+    memcpy(line, MSG_HEAD.str, MSG_HEAD.len);
+    memcpy(line + MSG_HEAD.len, text, tlen);
+    line[MSG_HEAD.len + tlen] = '\n';
+    *len = MSG_HEAD.len + tlen + 1;
+    return line;
 }
 
-static void broadcast_to_players(const broadcast_ctx_t *ctx)
+void broadcast_to_players(const broadcast_ctx_t *ctx)
 {
-    player_t *em = ctx->pl;
-    net_t *net = em->net;
-    char line[256];
-    player_t *rcv;
-    int dir;
+    player_t *em = player_alive(ctx->pl, ctx->owner);
+    net_t *net;
+    dir_batch_t *b;
+    size_t len;
+    char *line;
 
-    if (!net)
+    if (!em)
         return;
-    for (int i = 1; i < net->nfds; ++i) {
-        rcv = (player_t *)net->players[i];
-        if (!is_valid_receiver(rcv))
-            continue;
-        dir = compute_direction(em, rcv);
-        snprintf(line, sizeof(line), "message %d, %s\n", dir, ctx->msg);
-        write(rcv->fd, line, strlen(line));
+    net = em->net;
+    line = format_message(&net->tick, ctx->msg, &len);
+    b = &net->bcast;
+    gather_receivers(net, b);
+    dir_batch_compute(b, net->world, em->x, em->y);
+    for (int i = 0; line && i < b->count; ++i) {
+        line[MSG_DIGIT_AT] = (char)('0' + b->code[i]);
+        player_send(b->who[i], line, len);
     }
     gui_broadcast_pbc(net, em, ctx->msg);
+    journal_broadcast(net->world->journal, em->id, ctx->msg);
 }
 
+/* Skipped if the emitter left: its slot may already serve another client */
 static void exec_broadcast(struct s_player *raw)
 {
     broadcast_ctx_t *ctx = (broadcast_ctx_t *)raw;
-    player_t *em = ctx->pl;
+    player_t *em = player_alive(ctx->pl, ctx->owner);
 
-    broadcast_to_players(ctx);
-    if (em->q_len > 0)
-        --em->q_len;
-    free(ctx->msg);
-    free(ctx);
+    if (em) {
+        broadcast_to_players(ctx);
+        if (em->q_len > 0)
+            --em->q_len;
+    }
+    free_broadcast_ctx(ctx);
 }
 
 static bool enqueue_broadcast_action(broadcast_ctx_t *ctx,
@@ -120,9 +102,10 @@ static bool enqueue_broadcast_action(broadcast_ctx_t *ctx,
 {
     action_t act = {0};
 
-    act.exec_at = now_ms() + (7 * 1000ULL) / (uint64_t)freq;
+    act.exec_at = clock_now_ms() + (7 * 1000ULL) / (uint64_t)freq;
     act.fn = exec_broadcast;
     act.pl = (player_t *)ctx;
+    act.kind = ACT_BROADCAST;
     return scheduler_push(sched, act);
 }
 
@@ -131,20 +114,16 @@ bool try_push_broadcast_cmd(const char *line,
     scheduler_t *sched,
     int freq)
 {
-    const char *prefix = "Broadcast";
-    char *text = extract_broadcast_text(line, prefix);
+    const char *text = extract_broadcast_text(line, "Broadcast");
     broadcast_ctx_t *ctx;
 
     if (!text)
         return false;
-    ctx = create_broadcast_ctx(pl, text);
-    if (!ctx) {
-        free(text);
+    ctx = create_broadcast_ctx(sched, pl, text);
+    if (!ctx)
         return false;
-    }
     if (!enqueue_broadcast_action(ctx, sched, freq)) {
-        free(ctx->msg);
-        free(ctx);
+        free_broadcast_ctx(ctx);
         return false;
     }
     pl->q_len += 1;
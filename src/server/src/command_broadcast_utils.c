@@ -6,29 +6,45 @@
 */
 
 #include "command_broadcast_utils.h"
-#include <stdlib.h>
 #include <string.h>
 
-char *extract_broadcast_text(const char *line, const char *prefix)
+const char *extract_broadcast_text(const char *line, const char *prefix)
 {
     size_t plen = strlen(prefix);
 
     if (strncmp(line, prefix, plen) != 0)
         return NULL;
     if (line[plen] == '\0')
-        return strdup("");
+        return line + plen;
     if (line[plen] == ' ')
-        return strdup(line + plen + 1);
+        return line + plen + 1;
     return NULL;
 }
 
-broadcast_ctx_t *create_broadcast_ctx(player_t *pl, char *text)
+broadcast_ctx_t *create_broadcast_ctx(scheduler_t *sched, player_t *pl,
+    const char *text)
 {
-    broadcast_ctx_t *ctx = malloc(sizeof(*ctx));
+    size_t len = strlen(text);
+    broadcast_ctx_t *ctx;
 
+    if (len >= SCHED_TEXT_SZ)
+        return NULL;
+    ctx = slab_alloc(&sched->ctx);
     if (!ctx)
         return NULL;
+    ctx->msg = slab_alloc(&sched->text);
+    if (!ctx->msg) {
+        slab_free(ctx);
+        return NULL;
+    }
+    memcpy(ctx->msg, text, len + 1);
     ctx->pl = pl;
-    ctx->msg = text;
+    ctx->owner = pl->id;
     return ctx;
 }
+
+void free_broadcast_ctx(broadcast_ctx_t *ctx)
+{
+    slab_free(ctx->msg);
+    slab_free(ctx);
+}
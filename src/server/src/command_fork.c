@@ -11,6 +11,7 @@
 #include "net_poll.h"
 #include "team.h"
 #include "gui.h"
+#include "journal.h"
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
@@ -18,22 +19,24 @@
 void cmd_fork(struct s_player *p)
 {
     const char *OK = "ok\n";
-    egg_t *e;
+    const egg_t *e;
     gui_enw_t enw;
 
     if (!p || !p->net || p->team_idx < 0)
         return;
-    if (egg_create(p->net, p->x, p->y, p->team_idx)) {
+    e = egg_create(p->net, p->x, p->y, p->team_idx);
+    if (e) {
         p->net->teams[p->team_idx].slots += 1;
-        e = &p->net->eggs[p->net->egg_count - 1];
         gui_broadcast_pfk(p->net, p);
         enw.egg_id = e->id;
-        enw.player_id = p->fd;
+        enw.player_id = p->id;
         enw.x = e->x;
         enw.y = e->y;
         gui_broadcast_enw(p->net, &enw);
+        journal_event(p->world->journal, J_EGG_LAY, (uint64_t[]){
+            (uint64_t)e->id, p->id, (uint64_t)e->x, (uint64_t)e->y}, 4);
     }
-    write(p->fd, OK, strlen(OK));
+    player_send(p, OK, strlen(OK));
     if (p->q_len > 0)
         --p->q_len;
 }
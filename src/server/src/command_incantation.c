@@ -6,16 +6,16 @@
 */
 
 #include "incantation.h"
+#include "clock.h"
 #include "world.h"
 #include "net_poll.h"
 #include "gui.h"
 #include "incantation_utils.h"
-#include <stdlib.h>
+#include "journal.h"
 #include <string.h>
 #include <unistd.h>
-#include <sys/time.h>
 
-const req_t REQS[8] = {
+const req_t REQS[INCANTATION_MAX_LEVEL] = {
     {0, {0}},
     {1, {0, 1, 0, 0, 0, 0, 0}},
     {2, {0, 1, 1, 1, 0, 0, 0}},
@@ -26,111 +26,75 @@ const req_t REQS[8] = {
     {6, {0, 2, 2, 2, 2, 2, 1}},
 };
 
-static bool reqs_met(player_t *pl,
-    const tile_t *tile,
-    const req_t *req)
+static bool ritual_succeeds(const ritual_t *r, const tile_t *tile)
 {
-    int cnt = inc_count_players(pl->net,
-        pl->x, pl->y, pl->level);
+    const req_t *req = &REQS[r->level];
 
-    if (cnt < req->players)
-        return false;
-    return inc_resources_sufficient(tile, req->stones);
+    return tile && ritual_in_place_count(r) >= req->players &&
+        inc_resources_sufficient(tile, req->stones);
 }
 
 static void handle_failure(player_t *init)
 {
-    const char *ko = "ko\n";
-
-    write(init->fd, ko, strlen(ko));
-    if (init->q_len > 0)
-        --init->q_len;
-}
-
-static void handle_success(net_t *net, inc_ctx_t *ctx, tile_t *tile)
-{
-    inc_consume_resources(tile, REQS[ctx->level].stones);
-    inc_level_up_players(net, ctx->x, ctx->y, ctx->level);
+    if (init)
+        player_send(init, "ko\n", 3);
 }
 
-static tile_t *tile_at(world_t *w, int x, int y)
+static void handle_success(net_t *net, ritual_t *r, tile_t *tile)
 {
-    return world_get_tile(w, x, y);
+    inc_consume_resources(net->world, tile, REQS[r->level].stones);
+    inc_level_up_players(net, r);
 }
 
-static bool validate_incantation_context(inc_ctx_t *ctx,
-    player_t **init, net_t **net)
+static void journal_inc_end(journal_t *j, const inc_result_ctx_t *r)
 {
-    *init = ctx->initiator;
-    *net = *init ? (*init)->net : NULL;
-    if (!*init || !*net)
-        return false;
-    return true;
-}
-
-static int check_incantation_requirements(player_t *init,
-    tile_t *tile, int level)
-{
-    int success_start = reqs_met(init, tile, &REQS[level]);
-    int success_end = reqs_met(init, tile, &REQS[level]);
-
-    return (success_start && success_end) ? 1 : 0;
+    if (!journal_record(j, J_INC_END))
+        return;
+    journal_fields(j, (uint64_t[]){(uint64_t)r->ritual->x,
+        (uint64_t)r->ritual->y, (uint64_t)r->success}, 3);
+    for (int i = 0; i < RES_MAX; ++i)
+        journal_varint(j, r->tile->res[i]);
 }
 
-static void handle_incantation_result(inc_result_ctx_t *result_ctx)
+static void handle_incantation_result(inc_result_ctx_t *res)
 {
-    if (result_ctx->success)
-        handle_success(result_ctx->net, result_ctx->ctx, result_ctx->tile);
+    if (res->success)
+        handle_success(res->net, res->ritual, res->tile);
     else
-        handle_failure(result_ctx->init);
-    gui_broadcast_pie(result_ctx->net,
-        result_ctx->ctx->x, result_ctx->ctx->y, result_ctx->success);
-    gui_broadcast_tile(result_ctx->net,
-        result_ctx->ctx->x, result_ctx->ctx->y);
+        handle_failure(res->init);
+    if (res->init && res->init->q_len > 0)
+        --res->init->q_len;
+    gui_broadcast_pie(res->net, res->ritual->x, res->ritual->y, res->success);
+    gui_broadcast_tile(res->net, res->ritual->x, res->ritual->y);
+    if (res->tile)
+        journal_inc_end(res->net->world->journal, res);
 }
 
+/* Only the participants frozen at the start count and level up */
 static void exec_incantation(struct s_player *raw)
 {
-    inc_ctx_t *ctx = (inc_ctx_t *)raw;
-    player_t *init;
-    net_t *net;
-    tile_t *tile;
-    int success;
-    inc_result_ctx_t result_ctx;
-
-    if (!validate_incantation_context(ctx, &init, &net)) {
-        free(ctx);
-        return;
-    }
-    tile = tile_at(net->world, ctx->x, ctx->y);
-    success = check_incantation_requirements(init, tile, ctx->level);
-    result_ctx.net = net;
-    result_ctx.ctx = ctx;
-    result_ctx.tile = tile;
-    result_ctx.init = init;
-    result_ctx.success = success;
-    handle_incantation_result(&result_ctx);
-    free(ctx);
+    ritual_t *r = (ritual_t *)raw;
+    inc_result_ctx_t res = { .net = r->net, .ritual = r };
+
+    res.tile = world_get_tile(r->net->world, r->x, r->y);
+    res.init = ritual_member(r, r->initiator);
+    res.success = ritual_succeeds(r, res.tile);
+    handle_incantation_result(&res);
+    ritual_close(&r->net->rituals, r);
 }
 
-bool schedule_incantation(player_t *pl,
+bool schedule_incantation(ritual_t *r, player_t *pl,
     scheduler_t *sched, int freq)
 {
-    inc_ctx_t *ctx = malloc(sizeof(*ctx));
     action_t act = {0};
 
-    if (!ctx)
-        return false;
-    *ctx = (inc_ctx_t){ .initiator = pl,
-        .x = pl->x, .y = pl->y, .level = pl->level };
-    act.exec_at = inc_now_ms() +
+    act.exec_at = clock_now_ms() +
         (INCANTATION_DELAY * 1000ULL) / (uint64_t)freq;
     act.fn = exec_incantation;
-    act.pl = (player_t *)ctx;
-    if (!scheduler_push(sched, act)) {
-        free(ctx);
+    act.pl = (player_t *)r;
+    act.kind = ACT_INCANTATION;
+    if (!scheduler_push(sched, act))
         return false;
-    }
     pl->q_len += 1;
     return true;
 }
@@ -10,52 +10,94 @@
 #include "net_poll.h"
 #include "gui.h"
 #include "incantation_utils.h"
+#include "journal.h"
 #include <string.h>
 #include <unistd.h>
 
-static bool incantation_allowed(player_t *pl,
-    const req_t *req, const tile_t *tile)
+/* Same tile, same level, and not already frozen into another ritual */
+static bool can_join(const player_t *o, const player_t *pl)
 {
-    if (inc_count_players(pl->net, pl->x, pl->y, pl->level) < req->players)
-        return false;
-    return inc_resources_sufficient(tile, req->stones);
+    return o->authed && o->team_idx >= 0 && !o->ritual &&
+        o->x == pl->x && o->y == pl->y && o->level == pl->level;
 }
 
-static void send_incantation_start(player_t *pl)
+/* Walk backwards: joining prepends, so participants end up in fd order */
+static void gather_participants(ritual_t *r, player_t *pl)
 {
-    gui_pic_t pic = { .x = pl->x, .y = pl->y, .level = pl->level };
-    int ids[64];
-    size_t cnt = 0;
+    net_t *net = pl->net;
     player_t *o;
 
-    for (int i = 1; i < pl->net->nfds && cnt < 64; ++i) {
-        o = (player_t *)pl->net->players[i];
-        if (o && o->authed && o->team_idx >= 0 &&
-            o->x == pl->x && o->y == pl->y && o->level == pl->level) {
-            ids[cnt] = o->fd;
-            cnt++;
-        }
+    for (int i = net->nfds - 1; i >= net->nlisten; --i) {
+        o = (player_t *)net->players[i];
+        if (o && can_join(o, pl))
+            ritual_join(r, o);
     }
+}
+
+static ritual_t *open_ritual(player_t *pl, const req_t *req,
+    const tile_t *tile)
+{
+    ritual_t *r;
+
+    if (pl->ritual || tile->players < req->players ||
+        !inc_resources_sufficient(tile, req->stones))
+        return NULL;
+    r = ritual_open(&pl->net->rituals, pl);
+    if (!r)
+        return NULL;
+    gather_participants(r, pl);
+    if (r->count >= req->players)
+        return r;
+    ritual_close(&pl->net->rituals, r);
+    return NULL;
+}
+
+static void journal_inc_start(const player_t *pl, const gui_pic_t *pic)
+{
+    journal_t *j = pl->world->journal;
+
+    if (!journal_record(j, J_INC_START))
+        return;
+    journal_fields(j, (uint64_t[]){(uint64_t)pic->x, (uint64_t)pic->y,
+        (uint64_t)pic->level, pic->count}, 4);
+    for (size_t i = 0; i < pic->count; ++i)
+        journal_varint(j, pic->ids[i]);
+}
+
+static void send_incantation_start(player_t *pl, const ritual_t *r)
+{
+    gui_pic_t pic = { .x = r->x, .y = r->y, .level = r->level };
+    uint32_t ids[NET_MAX_FDS];
+    size_t cnt = 0;
+
+    for (const player_t *o = r->first; o && cnt < NET_MAX_FDS;
+        o = o->ritual_next)
+        ids[cnt++] = o->id;
     pic.ids = ids;
     pic.count = cnt;
     gui_broadcast_pic(pl->net, &pic);
+    journal_inc_start(pl, &pic);
 }
 
 bool try_push_incantation_cmd(const char *line,
     player_t *pl, scheduler_t *sched, int freq)
 {
-    const req_t *req;
     tile_t *tile;
+    ritual_t *r = NULL;
 
     if (strcmp(line, "Incantation") != 0 || !pl || !pl->world)
         return false;
-    req = &REQS[pl->level];
     tile = world_get_tile(pl->world, pl->x, pl->y);
-    if (!incantation_allowed(pl, req, tile)) {
-        write(pl->fd, "ko\n", 3);
+    if (tile && pl->net && pl->level < INCANTATION_MAX_LEVEL)
+        r = open_ritual(pl, &REQS[pl->level], tile);
+    if (!r) {
+        player_send(pl, "ko\n", 3);
         return true;
     }
-    send_incantation_start(pl);
-    write(pl->fd, "Elevation underway\n", 20);
-    return schedule_incantation(pl, sched, freq);
+    send_incantation_start(pl, r);
+    player_send(pl, "Elevation underway\n", 19);
+    if (schedule_incantation(r, pl, sched, freq))
+        return true;
+    ritual_close(&pl->net->rituals, r);
+    return false;
 }
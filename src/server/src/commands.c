@@ -6,6 +6,7 @@
 */
 
 #include "scheduler.h"
+#include "clock.h"
 #include "player.h"
 #include "world.h"
 #include "net_poll.h"
@@ -15,40 +16,32 @@
 #include "command_handlers.h"
 #include "command_broadcast.h"
 #include "incantation.h"
-#include <sys/time.h>
+#include "metrics.h"
+#include "journal.h"
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
 
 static const cmd_map_t CMD_MAP[] = {
-    {"Forward", cmd_forward, 7},
-    {"Right", cmd_right, 7},
-    {"Left", cmd_left, 7},
-    {"Look", cmd_look, 7},
-    {"Eject", cmd_eject, 7},
-    {"Fork", cmd_fork, 42},
-    {"Connect_nbr", cmd_connect_nbr, 0},
+    {"Forward", cmd_forward, 7, ACT_FORWARD},
+    {"Right", cmd_right, 7, ACT_RIGHT},
+    {"Left", cmd_left, 7, ACT_LEFT},
+    {"Look", cmd_look, 7, ACT_LOOK},
+    {"Eject", cmd_eject, 7, ACT_EJECT},
+    {"Fork", cmd_fork, 42, ACT_FORK},
+    {"Connect_nbr", cmd_connect_nbr, 0, ACT_CONNECT_NBR},
 };
 
-static uint64_t now_ms(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
-
 void cmd_forward(struct s_player *p)
 {
-    static const int DX[4] = {0, 1, 0, -1};
-    static const int DY[4] = {-1, 0, 1, 0};
     const char *msg = "ok\n";
 
-    p->x = (p->x + DX[p->dir] + p->world->w) % p->world->w;
-    p->y = (p->y + DY[p->dir] + p->world->h) % p->world->h;
-    write(p->fd, msg, strlen(msg));
+    player_move(p, (p->x + DIR_DX[p->dir] + p->world->w) % p->world->w,
+        (p->y + DIR_DY[p->dir] + p->world->h) % p->world->h);
+    player_send(p, msg, strlen(msg));
     if (p->net)
         gui_broadcast_ppo(p->net, p);
+    journal_player(p->world->journal, J_MOVE, p);
     if (p->q_len > 0)
         --p->q_len;
 }
@@ -58,9 +51,10 @@ void cmd_right(struct s_player *p)
     const char *msg = "ok\n";
 
     p->dir = (p->dir + 1) % 4;
-    write(p->fd, msg, strlen(msg));
+    player_send(p, msg, strlen(msg));
     if (p->net)
         gui_broadcast_ppo(p->net, p);
+    journal_player(p->world->journal, J_MOVE, p);
     if (p->q_len > 0)
         --p->q_len;
 }
@@ -70,9 +64,10 @@ void cmd_left(struct s_player *p)
     const char *msg = "ok\n";
 
     p->dir = (p->dir + 3) % 4;
-    write(p->fd, msg, strlen(msg));
+    player_send(p, msg, strlen(msg));
     if (p->net)
         gui_broadcast_ppo(p->net, p);
+    journal_player(p->world->journal, J_MOVE, p);
     if (p->q_len > 0)
         --p->q_len;
 }
@@ -85,7 +80,7 @@ void cmd_connect_nbr(struct s_player *p)
     if (p->team_idx >= 0 && p->net && p->net->teams)
         slots = p->net->teams[p->team_idx].slots;
     snprintf(buf, sizeof(buf), "%d\n", slots);
-    write(p->fd, buf, strlen(buf));
+    player_send(p, buf, strlen(buf));
     if (p->q_len > 0)
         --p->q_len;
 }
@@ -106,9 +101,10 @@ static bool try_push_cmd(const char *line, struct s_player *pl,
 
     if (!cmd)
         return false;
-    act.exec_at = now_ms() + (cmd->cost * 1000ULL) / (uint64_t)freq;
+    act.exec_at = clock_now_ms() + (cmd->cost * 1000ULL) / (uint64_t)freq;
     act.fn = cmd->fn;
     act.pl = pl;
+    act.kind = cmd->kind;
     if (!scheduler_push(sched, act))
         return false;
     pl->q_len += 1;
@@ -125,6 +121,8 @@ bool sched_cmd_from_string(struct s_player *pl, const char *line,
         try_push_broadcast_cmd(line, pl, s, freq) ||
         try_push_incantation_cmd(line, pl, s, freq))
         return true;
-    write(pl->fd, ko, strlen(ko));
+    if (s->metrics)
+        metrics_add(s->metrics, M_CMD_REJECTED, 1);
+    player_send(pl, ko, strlen(ko));
     return false;
 }
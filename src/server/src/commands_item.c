@@ -6,65 +6,89 @@
 */
 
 #include "item_commands.h"
+#include "clock.h"
 #include "item_helpers.h"
 #include "world.h"
 #include "gui.h"
+#include "journal.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <sys/time.h>
 #include <stdint.h>
 
-static uint64_t inv_now_ms(void)
+_Static_assert(sizeof(item_ctx_t) <= SCHED_CTX_SZ,
+    "an item context must fit a scheduler slab block");
+
+static const token_t INV_LABELS[RES_MAX] = {
+    TOKEN("[ food "), TOKEN(", linemate "), TOKEN(", deraumere "),
+    TOKEN(", sibur "), TOKEN(", mendiane "), TOKEN(", phiras "),
+    TOKEN(", thystame ")
+};
+
+static bool append_inventory(outbuf_t *out, const uint16_t *inv,
+    uint64_t ttl_sec)
 {
-    struct timeval tv;
+    static const token_t life = TOKEN(", life ");
+    static const token_t end = TOKEN(" ]\n");
+    bool ok = true;
 
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
+    for (res_t r = 0; r < RES_MAX && ok; ++r)
+        ok = outbuf_append(out, INV_LABELS[r].str, INV_LABELS[r].len) &&
+            outbuf_append_uint(out, inv[r]);
+    return ok && outbuf_append(out, life.str, life.len) &&
+        outbuf_append_uint(out, ttl_sec) &&
+        outbuf_append(out, end.str, end.len);
 }
 
 static void exec_inventory(struct s_player *p)
 {
-    char buf[192];
     uint64_t period_ms = 126000ULL / (uint64_t)p->freq;
-    uint64_t now = inv_now_ms();
+    uint64_t now = clock_now_ms();
     uint64_t first_slice_ms =
         (p->next_food > now) ? (p->next_food - now) : 0ULL;
     uint64_t ttl_ms = first_slice_ms + (uint64_t)p->inv[RES_FOOD] * period_ms;
-    uint64_t ttl_sec = ttl_ms / 1000ULL;
-
-    snprintf(buf, sizeof(buf),
-        "[ food %u, linemate %u, deraumere %u, sibur %u, mendiane %u, "
-        "phiras %u, thystame %u, life %llu ]\n",
-        p->inv[RES_FOOD], p->inv[RES_LINEMATE], p->inv[RES_DERAUMERE],
-        p->inv[RES_SIBUR], p->inv[RES_MENDIANE], p->inv[RES_PHIRAS],
-        p->inv[RES_THYSTAME], (unsigned long long)ttl_sec);
-    ih_reply(p->fd, buf);
+
+    if (!append_inventory(&p->out, p->inv, ttl_ms / 1000ULL))
+        p->doomed = true;
     if (p->q_len > 0)
         --p->q_len;
 }
 
-static void exec_item_action(struct s_player *raw)
+static void notify_item_action(player_t *p, const item_ctx_t *ctx)
 {
-    item_ctx_t *ctx = (item_ctx_t *)raw;
-    player_t *p = ctx->pl;
-    tile_t *t = &p->world->tiles[p->y * p->world->w + p->x];
-    bool ok = ctx->take
+    journal_event(p->world->journal, ctx->take ? J_TAKE : J_SET,
+        (uint64_t[]){p->id, (uint64_t)ctx->id}, 2);
+    if (ctx->take)
+        gui_broadcast_pgt(p->net, p, ctx->id);
+    else
+        gui_broadcast_pdr(p->net, p, ctx->id);
+    gui_refresh_bct_pin(p->net, p);
+}
+
+static void run_item_action(player_t *p, const item_ctx_t *ctx)
+{
+    tile_t *t = world_get_tile(p->world, p->x, p->y);
+    bool ok = t && (ctx->take
         ? ih_perform_take(p, ctx->id, t)
-        : ih_perform_set(p, ctx->id, t);
-
-    ih_reply(p->fd, ok ? "ok\n" : "ko\n");
-    if (ok && p->net) {
-        if (ctx->take)
-            gui_broadcast_pgt(p->net, p, ctx->id);
-        else
-            gui_broadcast_pdr(p->net, p, ctx->id);
-        gui_refresh_bct_pin(p->net, p);
-    }
+        : ih_perform_set(p, ctx->id, t));
+
+    ih_reply(p, ok ? "ok\n" : "ko\n");
+    if (ok)
+        notify_item_action(p, ctx);
     if (p->q_len > 0)
         --p->q_len;
-    free(ctx);
+}
+
+/* Skipped if the owner left: its slot may already serve another client */
+static void exec_item_action(struct s_player *raw)
+{
+    item_ctx_t *ctx = (item_ctx_t *)raw;
+    player_t *p = player_alive(ctx->pl, ctx->owner);
+
+    if (p)
+        run_item_action(p, ctx);
+    slab_free(ctx);
 }
 
 static bool schedule_inventory(player_t *pl, scheduler_t *sched, int freq)
@@ -72,9 +96,10 @@ static bool schedule_inventory(player_t *pl, scheduler_t *sched, int freq)
     action_t act = {0};
     bool ok;
 
-    act.exec_at = ih_now_ms() + (1000ULL) / (uint64_t)freq;
+    act.exec_at = clock_now_ms() + (1000ULL) / (uint64_t)freq;
     act.fn = exec_inventory;
     act.pl = pl;
+    act.kind = ACT_INVENTORY;
     ok = scheduler_push(sched, act);
     if (ok)
         pl->q_len += 1;
@@ -86,21 +111,23 @@ static bool schedule_item_action(player_t *pl,
     int freq,
     item_params_t params)
 {
-    item_ctx_t *ctx = malloc(sizeof(*ctx));
+    item_ctx_t *ctx = slab_alloc(&sched->ctx);
     action_t act = {0};
     bool ok2;
 
     if (!ctx)
         return false;
-    ctx->pl = pl;
-    ctx->id = params.id;
-    ctx->take = (params.op == ITEM_OP_TAKE);
-    act.exec_at = ih_now_ms() + (7 * 1000ULL) / (uint64_t)freq;
+    *ctx = (item_ctx_t){.pl = pl, .owner = pl->id, .id = params.id,
+        .take = (params.op == ITEM_OP_TAKE)};
+    act.exec_at = clock_now_ms() + (7 * 1000ULL) / (uint64_t)freq;
     act.fn = exec_item_action;
     act.pl = (player_t *)ctx;
+    act.kind = ctx->take ? ACT_TAKE : ACT_SET;
     ok2 = scheduler_push(sched, act);
     if (ok2)
         pl->q_len += 1;
+    else
+        slab_free(ctx);
     return ok2;
 }
 
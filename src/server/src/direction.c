@@ -0,0 +1,47 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** direction.c - sound direction shared by Broadcast and Eject
+*/
+
+#include "direction.h"
+#include "player.h"
+
+const int DIR_DX[4] = {0, 1, 0, -1};
+const int DIR_DY[4] = {-1, 0, 1, 0};
+
+/* Direction for a north-facing receiver, indexed by [sign(dy)][sign(dx)] */
+static const uint8_t BASE_DIR[3][3] = {
+    {8, 1, 2},
+    {7, 0, 3},
+    {6, 5, 4}
+};
+
+/* Shortest wrapped delta along one axis, written without branches */
+static inline int wrap_delta(int d, int max)
+{
+    d -= max & -(d > max / 2);
+    d += max & -(d < -max / 2);
+    return d;
+}
+
+static inline int direction_code(int dx, int dy, int ori)
+{
+    int base = BASE_DIR[(dy > 0) - (dy < 0) + 1][(dx > 0) - (dx < 0) + 1];
+
+    return base ? ((base - 1 - 2 * ori) & 7) + 1 : 0;
+}
+
+int sound_direction(const world_t *w, int ex, int ey, const player_t *rcv)
+{
+    return direction_code(wrap_delta(ex - rcv->x, w->w),
+        wrap_delta(ey - rcv->y, w->h), rcv->dir);
+}
+
+void dir_batch_compute(dir_batch_t *b, const world_t *w, int ex, int ey)
+{
+    for (int i = 0; i < b->count; ++i)
+        b->code[i] = (uint8_t)direction_code(wrap_delta(ex - b->x[i], w->w),
+            wrap_delta(ey - b->y[i], w->h), b->dir[i]);
+}
@@ -0,0 +1,86 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** drift.c - per-command lateness histograms
+*/
+
+#include "drift.h"
+#include <stdio.h>
+
+static int bucket_of(uint64_t us)
+{
+    int e;
+
+    if (us < DRIFT_SUB)
+        return (int)us;
+    e = 63 - __builtin_clzll(us);
+    if (e >= DRIFT_MAX_EXP)
+        return DRIFT_BUCKETS - 1;
+    return (e - DRIFT_SUB_BITS + 1) * DRIFT_SUB +
+        (int)((us >> (e - DRIFT_SUB_BITS)) & (DRIFT_SUB - 1));
+}
+
+static uint64_t bucket_high(int idx)
+{
+    int e = idx / DRIFT_SUB + DRIFT_SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(idx % DRIFT_SUB);
+
+    if (idx < DRIFT_SUB)
+        return (uint64_t)idx;
+    return ((DRIFT_SUB + sub + 1) << (e - DRIFT_SUB_BITS)) - 1;
+}
+
+void drift_record(drift_hist_t *h, uint64_t us)
+{
+    atomic_fetch_add_explicit(&h->counts[bucket_of(us)], 1,
+        memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->total, 1, memory_order_relaxed);
+    if (us > atomic_load_explicit(&h->max_us, memory_order_relaxed))
+        atomic_store_explicit(&h->max_us, us, memory_order_relaxed);
+}
+
+uint64_t drift_quantile(const drift_hist_t *h, double q)
+{
+    uint64_t total = atomic_load_explicit(&h->total, memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&h->max_us, memory_order_relaxed);
+    uint64_t rank = (uint64_t)(q * (double)total + 0.999999);
+    uint64_t seen = 0;
+
+    if (rank == 0)
+        rank = 1;
+    for (int i = 0; i < DRIFT_BUCKETS && total; ++i) {
+        seen += atomic_load_explicit(&h->counts[i], memory_order_relaxed);
+        if (seen >= rank)
+            return bucket_high(i) < max ? bucket_high(i) : max;
+    }
+    return max;
+}
+
+static bool render_line(const drift_hist_t *h, act_kind_t kind, outbuf_t *ob)
+{
+    char line[160];
+    int n = snprintf(line, sizeof(line),
+        "%-12s %10llu %8llu %8llu %8llu %8llu %8llu\n", act_kind_name(kind),
+        (unsigned long long)atomic_load_explicit(&h->total,
+            memory_order_relaxed),
+        (unsigned long long)drift_quantile(h, 0.5),
+        (unsigned long long)drift_quantile(h, 0.9),
+        (unsigned long long)drift_quantile(h, 0.99),
+        (unsigned long long)drift_quantile(h, 0.999),
+        (unsigned long long)atomic_load_explicit(&h->max_us,
+            memory_order_relaxed));
+
+    return n > 0 && outbuf_append(ob, line, (size_t)n);
+}
+
+bool drift_render(const drift_hist_t hists[ACT_KINDS], outbuf_t *ob)
+{
+    static const char head[] = "# lateness in microseconds\n"
+        "command           count      p50      p90      p99    p99.9      max\n";
+    bool ok = outbuf_append(ob, head, sizeof(head) - 1);
+
+    for (int k = 0; k < ACT_KINDS && ok; ++k)
+        ok = render_line(&hists[k], (act_kind_t)k, ob);
+    return ok;
+}
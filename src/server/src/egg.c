@@ -8,6 +8,8 @@
 #include "egg.h"
 #include "net_poll.h"
 #include "gui.h"
+#include "journal.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
 
@@ -19,37 +21,131 @@ static void set_coords(const egg_t *e, int *x, int *y)
         *y = e->y;
 }
 
-bool egg_create(net_t *net, int x, int y, int team_idx)
+bool egg_pool_init(egg_pool_t *pool, int team_cnt, world_t *world)
 {
-    egg_t *e;
+    memset(pool, 0, sizeof(*pool));
+    pool->free_head = -1;
+    pool->world = world;
+    pool->next_id = 1;
+    pool->team_head = malloc((size_t)team_cnt * sizeof(int));
+    if (!pool->team_head)
+        return false;
+    memset(pool->team_head, -1, (size_t)team_cnt * sizeof(int));
+    return true;
+}
+
+void egg_pool_destroy(egg_pool_t *pool)
+{
+    free(pool->eggs);
+    free(pool->team_head);
+    memset(pool, 0, sizeof(*pool));
+}
+
+static int *list_head(egg_pool_t *pool, egg_list_t k, const egg_t *e)
+{
+    if (k == EGG_BY_TEAM)
+        return &pool->team_head[e->team_idx];
+    return &world_get_tile(pool->world, e->x, e->y)->egg_head;
+}
+
+static void list_push(egg_pool_t *pool, egg_list_t k, int i)
+{
+    int *head = list_head(pool, k, &pool->eggs[i]);
+    egg_link_t *l = &pool->eggs[i].link[k];
+
+    l->prev = -1;
+    l->next = *head;
+    if (*head >= 0)
+        pool->eggs[*head].link[k].prev = i;
+    *head = i;
+}
+
+static void list_remove(egg_pool_t *pool, egg_list_t k, int i)
+{
+    int *head = list_head(pool, k, &pool->eggs[i]);
+    egg_link_t *l = &pool->eggs[i].link[k];
+
+    if (l->prev >= 0)
+        pool->eggs[l->prev].link[k].next = l->next;
+    else
+        *head = l->next;
+    if (l->next >= 0)
+        pool->eggs[l->next].link[k].prev = l->prev;
+}
 
-    if (!net || net->egg_count >= EGG_MAX)
+static bool grow(egg_pool_t *pool)
+{
+    int cap = pool->cap ? pool->cap * 2 : EGG_MIN_CAP;
+    egg_t *eggs = realloc(pool->eggs, (size_t)cap * sizeof(*eggs));
+
+    if (!eggs)
         return false;
-    e = &net->eggs[net->egg_count];
-    e->id = net->next_egg_id;
-    net->next_egg_id += 1;
+    for (int i = cap - 1; i >= pool->cap; --i) {
+        eggs[i].link[EGG_BY_TEAM].next = pool->free_head;
+        pool->free_head = i;
+    }
+    pool->eggs = eggs;
+    pool->cap = cap;
+    return true;
+}
+
+/* Unlinks the egg from both lists and puts its slot back on the free list */
+static void release(egg_pool_t *pool, int i)
+{
+    list_remove(pool, EGG_BY_TEAM, i);
+    list_remove(pool, EGG_BY_TILE, i);
+    pool->eggs[i].link[EGG_BY_TEAM].next = pool->free_head;
+    pool->free_head = i;
+    pool->count -= 1;
+}
+
+const egg_t *egg_create(net_t *net, int x, int y, int team_idx)
+{
+    egg_pool_t *pool = &net->eggs;
+    egg_t *e;
+    int i;
+
+    if (pool->free_head < 0 && !grow(pool))
+        return NULL;
+    i = pool->free_head;
+    e = &pool->eggs[i];
+    pool->free_head = e->link[EGG_BY_TEAM].next;
+    e->id = pool->next_id++;
     e->x = x;
     e->y = y;
     e->team_idx = team_idx;
-    net->egg_count += 1;
-    return true;
+    list_push(pool, EGG_BY_TEAM, i);
+    list_push(pool, EGG_BY_TILE, i);
+    pool->count += 1;
+    return e;
 }
 
 bool egg_hatch(net_t *net, int team_idx, int *x, int *y)
 {
-    int egg_id;
+    egg_pool_t *pool = &net->eggs;
+    int i = pool->team_head[team_idx];
 
-    if (!net || net->egg_count == 0)
+    if (i < 0)
         return false;
-    for (int i = 0; i < net->egg_count; ++i) {
-        if (net->eggs[i].team_idx != team_idx)
-            continue;
-        egg_id = net->eggs[i].id;
-        set_coords(&net->eggs[i], x, y);
-        gui_broadcast_ebo(net, egg_id);
-        net->eggs[i] = net->eggs[net->egg_count - 1];
-        net->egg_count -= 1;
-        return true;
+    set_coords(&pool->eggs[i], x, y);
+    gui_broadcast_ebo(net, pool->eggs[i].id);
+    journal_event(pool->world->journal, J_EGG_HATCH,
+        (uint64_t[]){(uint64_t)pool->eggs[i].id}, 1);
+    release(pool, i);
+    return true;
+}
+
+void egg_destroy_on_tile(net_t *net, int x, int y)
+{
+    egg_pool_t *pool = &net->eggs;
+    const tile_t *t = world_peek_tile(pool->world, x, y);
+    int i;
+
+    while (t->egg_head >= 0) {
+        i = t->egg_head;
+        gui_broadcast_ebo(net, pool->eggs[i].id);
+        journal_event(pool->world->journal, J_EGG_DIE,
+            (uint64_t[]){(uint64_t)pool->eggs[i].id}, 1);
+        release(pool, i);
     }
-    return false;
 }
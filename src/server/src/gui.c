@@ -14,9 +14,9 @@
 #include <string.h>
 #include <unistd.h>
 
-static void send_bct_fd(int fd, int x, int y, const tile_t *t)
+bool gui_write_bct(outbuf_t *ob, int x, int y, const tile_t *t)
 {
-    sock_printf(fd,
+    return sock_printf(ob,
         "bct %d %d %u %u %u %u %u %u %u\n",
         x, y,
         t->res[RES_FOOD], t->res[RES_LINEMATE],
@@ -25,45 +25,59 @@ static void send_bct_fd(int fd, int x, int y, const tile_t *t)
         t->res[RES_THYSTAME]);
 }
 
-static void send_full_map_fd(int fd, const world_t *w)
+bool gui_write_map(outbuf_t *ob, const world_t *w)
 {
+    bool ok = true;
+
     for (int y = 0; y < w->h; ++y)
         for (int x = 0; x < w->w; ++x)
-            send_bct_fd(fd, x, y, &w->tiles[y * w->w + x]);
+            ok = gui_write_bct(ob, x, y, world_peek_tile(w, x, y)) && ok;
+    return ok;
 }
 
-static void send_all_players_fd(int fd, const net_t *net)
+static bool send_all_players_fd(outbuf_t *ob, const net_t *net)
 {
     int o;
     const player_t *pl;
+    bool ok = true;
 
-    for (int i = 1; i < net->nfds; ++i) {
+    for (int i = net->nlisten; i < net->nfds; ++i) {
         pl = (const player_t *)net->players[i];
         if (!pl || !pl->authed || pl->team_idx < 0)
             continue;
         o = pl->dir + 1;
-        sock_printf(fd,
-            "pnw #%d %d %d %d %d %s\n",
-            pl->fd, pl->x, pl->y, o, pl->level,
-            net->teams[pl->team_idx].name);
+        ok = sock_printf(ob,
+            "pnw #%u %d %d %d %d %s\n",
+            pl->id, pl->x, pl->y, o, pl->level,
+            net->teams[pl->team_idx].name) && ok;
     }
+    return ok;
 }
 
-void gui_send_initial(net_t *net, int fd)
+bool gui_build_snapshot(const net_t *net, outbuf_t *ob)
 {
-    sock_printf(fd, "msz %d %d\n", net->world->w, net->world->h);
-    send_full_map_fd(fd, net->world);
+    bool ok = sock_printf(ob, "msz %d %d\n", net->world->w, net->world->h);
+
+    ok = gui_write_map(ob, net->world) && ok;
     for (int i = 0; i < net->team_cnt; ++i)
-        sock_printf(fd, "tna %s\n", net->teams[i].name);
-    send_all_players_fd(fd, net);
-    sock_printf(fd, "sgt %d\n", net->freq);
+        ok = sock_printf(ob, "tna %s\n", net->teams[i].name) && ok;
+    ok = send_all_players_fd(ob, net) && ok;
+    return sock_printf(ob, "sgt %d\n", net->freq) && ok;
+}
+
+void gui_send_initial(net_t *net, player_t *gui)
+{
+    if (!gui_build_snapshot(net, &gui->out))
+        gui->doomed = true;
+    else
+        player_flush(gui);
 }
 
 void gui_broadcast_tile(net_t *net, int x, int y)
 {
     char line[GUI_BUF_SZ];
     size_t n;
-    tile_t *t = &net->world->tiles[y * net->world->w + x];
+    const tile_t *t = world_peek_tile(net->world, x, y);
 
     n = (size_t)snprintf(line, sizeof(line),
         "bct %d %d %u %u %u %u %u %u %u\n",
@@ -77,16 +91,9 @@ void gui_broadcast_tile(net_t *net, int x, int y)
 
 void gui_broadcast_pnw(net_t *net, const player_t *pl)
 {
-    char line[GUI_BUF_SZ];
-    int o = pl->dir + 1;
-    int n = snprintf(line, sizeof(line),
-        "pnw #%d %d %d %d %d %s\n",
-        pl->fd, pl->x, pl->y, o, pl->level,
+    broadcast_printf(net, "pnw #%u %d %d %d %d %s\n",
+        pl->id, pl->x, pl->y, pl->dir + 1, pl->level,
         net->teams[pl->team_idx].name);
-
-    if (n < 0)
-        return;
-    broadcast(net, line, (size_t)n);
 }
 
 void gui_broadcast_ppo(net_t *net, const player_t *pl)
@@ -94,8 +101,8 @@ void gui_broadcast_ppo(net_t *net, const player_t *pl)
     char line[GUI_BUF_SZ];
     int o = pl->dir + 1;
     int n = snprintf(line, sizeof(line),
-        "ppo #%d %d %d %d\n",
-        pl->fd, pl->x, pl->y, o);
+        "ppo #%u %d %d %d\n",
+        pl->id, pl->x, pl->y, o);
 
     if (n < 0)
         return;
@@ -105,7 +112,7 @@ void gui_broadcast_ppo(net_t *net, const player_t *pl)
 void gui_broadcast_pdi(net_t *net, const player_t *pl)
 {
     char line[GUI_BUF_SZ];
-    int n = snprintf(line, sizeof(line), "pdi #%d\n", pl->fd);
+    int n = snprintf(line, sizeof(line), "pdi #%u\n", pl->id);
 
     if (n < 0)
         return;
@@ -16,7 +16,7 @@ void gui_broadcast_enw(net_t *net, const gui_enw_t *info)
 
     if (!info)
         return;
-    n = snprintf(line, sizeof(line), "enw #%d #%d %d %d\n",
+    n = snprintf(line, sizeof(line), "enw #%d #%u %d %d\n",
         info->egg_id, info->player_id, info->x, info->y);
     if (n < 0)
         return;
@@ -9,22 +9,11 @@
 #include <stdio.h>
 #include <unistd.h>
 
-static size_t write_pic_prefix(char *buf, const gui_pic_t *info)
+static size_t add_pic_ids(char *buf, size_t len, size_t cap,
+    const gui_pic_t *info)
 {
-    return (size_t)snprintf(buf, PIC_BUF_SZ, "pic %d %d %d",
-        info->x, info->y, info->level);
-}
-
-static size_t add_pic_ids(char *buf, size_t len, const gui_pic_t *info)
-{
-    int n;
-
-    for (size_t i = 0; i < info->count && len < PIC_BUF_SZ - 10; ++i) {
-        n = snprintf(buf + len, PIC_BUF_SZ - len, " #%d", info->ids[i]);
-        if (n < 0)
-            break;
-        len += (size_t)n;
-    }
+    for (size_t i = 0; i < info->count; ++i)
+        len += (size_t)snprintf(buf + len, cap - len, " #%u", info->ids[i]);
     return len;
 }
 
@@ -38,20 +27,22 @@ void gui_broadcast_pie(net_t *net, int x, int y, int result)
     broadcast(net, line, (size_t)n);
 }
 
+/* Sized from the participant count, so no ID is ever left out */
 void gui_broadcast_pic(net_t *net, const gui_pic_t *info)
 {
-    char buf[PIC_BUF_SZ];
+    size_t cap;
     size_t len;
+    char *buf;
 
     if (!info || !net)
         return;
-    len = write_pic_prefix(buf, info);
-    if (len >= PIC_BUF_SZ)
+    cap = PIC_HEAD_MAX + info->count * PIC_ID_MAX + 1;
+    buf = arena_alloc(&net->tick, cap);
+    if (!buf)
         return;
-    len = add_pic_ids(buf, len, info);
-    if (len >= PIC_BUF_SZ - 1)
-        len = PIC_BUF_SZ - 2;
+    len = (size_t)snprintf(buf, cap, "pic %d %d %d",
+        info->x, info->y, info->level);
+    len = add_pic_ids(buf, len, cap, info);
     buf[len] = '\n';
-    len++;
-    broadcast(net, buf, len);
+    broadcast(net, buf, len + 1);
 }
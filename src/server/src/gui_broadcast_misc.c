@@ -7,43 +7,42 @@
 
 #include "gui.h"
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
-void gui_broadcast_pbc(net_t *net, const player_t *pl, const char *text)
+/* "<head><text>\n", built in the tick arena: the text comes from a client
+   or the command line and can be longer than any fixed line buffer */
+static void broadcast_text(net_t *net, const char *head, size_t hlen,
+    const char *text)
 {
-    char line[GUI_BUF_SZ];
-    int n;
+    size_t tlen = text ? strlen(text) : 0;
+    char *line = arena_alloc(&net->tick, hlen + tlen + 1);
 
-    if (!text)
-        text = "";
-    n = snprintf(line, sizeof(line), "pbc #%d %s\n", pl->fd, text);
-    if (n < 0)
+    if (!line)
         return;
-    broadcast(net, line, (size_t)n);
+    memcpy(line, head, hlen);
+    if (tlen)
+        memcpy(line + hlen, text, tlen);
+    line[hlen + tlen] = '\n';
+    broadcast(net, line, hlen + tlen + 1);
 }
 
-void gui_broadcast_seg(net_t *net, const char *team_name)
+void gui_broadcast_pbc(net_t *net, const player_t *pl, const char *text)
 {
-    char line[GUI_BUF_SZ];
-    int n;
+    char head[GUI_BUF_SZ];
+    int n = snprintf(head, sizeof(head), "pbc #%u ", pl->id);
 
-    if (!team_name)
-        team_name = "";
-    n = snprintf(line, sizeof(line), "seg %s\n", team_name);
     if (n < 0)
         return;
-    broadcast(net, line, (size_t)n);
+    broadcast_text(net, head, (size_t)n, text);
 }
 
-void gui_broadcast_smg(net_t *net, const char *msg)
+void gui_broadcast_seg(net_t *net, const char *team_name)
 {
-    char line[GUI_BUF_SZ];
-    int n;
+    broadcast_text(net, "seg ", 4, team_name);
+}
 
-    if (!msg)
-        msg = "";
-    n = snprintf(line, sizeof(line), "smg %s\n", msg);
-    if (n < 0)
-        return;
-    broadcast(net, line, (size_t)n);
+void gui_broadcast_smg(net_t *net, const char *msg)
+{
+    broadcast_text(net, "smg ", 4, msg);
 }
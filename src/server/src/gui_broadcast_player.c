@@ -12,7 +12,7 @@
 void gui_broadcast_pex(net_t *net, const player_t *pl)
 {
     char line[GUI_BUF_SZ];
-    int n = snprintf(line, sizeof(line), "pex #%d\n", pl->fd);
+    int n = snprintf(line, sizeof(line), "pex #%u\n", pl->id);
 
     if (n < 0)
         return;
@@ -22,7 +22,7 @@ void gui_broadcast_pex(net_t *net, const player_t *pl)
 void gui_broadcast_pfk(net_t *net, const player_t *pl)
 {
     char line[GUI_BUF_SZ];
-    int n = snprintf(line, sizeof(line), "pfk #%d\n", pl->fd);
+    int n = snprintf(line, sizeof(line), "pfk #%u\n", pl->id);
 
     if (n < 0)
         return;
@@ -32,7 +32,7 @@ void gui_broadcast_pfk(net_t *net, const player_t *pl)
 void gui_broadcast_plv(net_t *net, const player_t *pl)
 {
     char line[GUI_BUF_SZ];
-    int n = snprintf(line, sizeof(line), "plv #%d %d\n", pl->fd, pl->level);
+    int n = snprintf(line, sizeof(line), "plv #%u %d\n", pl->id, pl->level);
 
     if (n < 0)
         return;
@@ -22,10 +22,9 @@ void gui_broadcast_full_map(net_t *net)
 void gui_broadcast_pin(net_t *net, const player_t *pl)
 {
     char line[GUI_BUF_SZ];
-    player_t *cli;
     int n = snprintf(line, sizeof(line),
-        "pin #%d %d %d %u %u %u %u %u %u %u\n",
-        pl->fd, pl->x, pl->y,
+        "pin #%u %d %d %u %u %u %u %u %u %u\n",
+        pl->id, pl->x, pl->y,
         pl->inv[RES_FOOD], pl->inv[RES_LINEMATE],
         pl->inv[RES_DERAUMERE], pl->inv[RES_SIBUR],
         pl->inv[RES_MENDIANE], pl->inv[RES_PHIRAS],
@@ -34,9 +33,5 @@ void gui_broadcast_pin(net_t *net, const player_t *pl)
     if (n < 0)
         return;
     gui_broadcast_tile(net, pl->x, pl->y);
-    for (int i = 1; i < net->nfds; ++i) {
-        cli = (player_t *)net->players[i];
-        if (IS_GUI(cli))
-            write(net->pfds[i].fd, line, (size_t)n);
-    }
+    broadcast(net, line, (size_t)n);
 }
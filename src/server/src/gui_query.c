@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** gui_query - commands sent by GUI clients
+*/
+
+#include "gui_query.h"
+#include "gui.h"
+#include "timescale.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool q_msz(net_t *net, player_t *gui, const char *args)
+{
+    (void)args;
+    sock_printf(&gui->out, "msz %d %d\n", net->world->w, net->world->h);
+    return true;
+}
+
+static bool q_bct(net_t *net, player_t *gui, const char *args)
+{
+    int x;
+    int y;
+
+    if (sscanf(args, "%d %d", &x, &y) != 2 || x < 0 || y < 0 ||
+        x >= net->world->w || y >= net->world->h)
+        return false;
+    gui_write_bct(&gui->out, x, y, world_peek_tile(net->world, x, y));
+    return true;
+}
+
+static bool q_mct(net_t *net, player_t *gui, const char *args)
+{
+    (void)args;
+    gui_write_map(&gui->out, net->world);
+    return true;
+}
+
+static bool q_tna(net_t *net, player_t *gui, const char *args)
+{
+    (void)args;
+    for (int i = 0; i < net->team_cnt; ++i)
+        sock_printf(&gui->out, "tna %s\n", net->teams[i].name);
+    return true;
+}
+
+/* "#n" or "n": a player in a team, still connected */
+static const player_t *find_player(net_t *net, const char *args)
+{
+    unsigned id;
+    const player_t *pl;
+
+    if (sscanf(args + (args[0] == '#'), "%u", &id) != 1)
+        return NULL;
+    pl = player_by_id(&net->pool, id);
+    return pl && pl->authed && pl->team_idx >= 0 ? pl : NULL;
+}
+
+static bool q_ppo(net_t *net, player_t *gui, const char *args)
+{
+    const player_t *pl = find_player(net, args);
+
+    if (!pl)
+        return false;
+    sock_printf(&gui->out, "ppo #%u %d %d %d\n", pl->id, pl->x, pl->y,
+        pl->dir + 1);
+    return true;
+}
+
+static bool q_plv(net_t *net, player_t *gui, const char *args)
+{
+    const player_t *pl = find_player(net, args);
+
+    if (!pl)
+        return false;
+    sock_printf(&gui->out, "plv #%u %d\n", pl->id, pl->level);
+    return true;
+}
+
+static bool q_pin(net_t *net, player_t *gui, const char *args)
+{
+    const player_t *pl = find_player(net, args);
+
+    if (!pl)
+        return false;
+    sock_printf(&gui->out, "pin #%u %d %d %u %u %u %u %u %u %u\n",
+        pl->id, pl->x, pl->y, pl->inv[RES_FOOD], pl->inv[RES_LINEMATE],
+        pl->inv[RES_DERAUMERE], pl->inv[RES_SIBUR], pl->inv[RES_MENDIANE],
+        pl->inv[RES_PHIRAS], pl->inv[RES_THYSTAME]);
+    return true;
+}
+
+static bool q_sgt(net_t *net, player_t *gui, const char *args)
+{
+    (void)args;
+    sock_printf(&gui->out, "sgt %d\n", net->freq);
+    return true;
+}
+
+/* Every GUI hears the new time unit, not only the one that set it */
+static bool q_sst(net_t *net, player_t *gui, const char *args)
+{
+    char line[GUI_BUF_SZ];
+    char *end;
+    long freq = strtol(args, &end, 10);
+    int n;
+
+    (void)gui;
+    if (end == args || *end || freq <= 0 || freq > INT_MAX ||
+        !timescale_set(net, (int)freq))
+        return false;
+    n = snprintf(line, sizeof(line), "sst %d\n", net->freq);
+    broadcast(net, line, (size_t)n);
+    return true;
+}
+
+static const gui_query_t QUERIES[] = {
+    {"msz", q_msz}, {"bct", q_bct}, {"mct", q_mct}, {"tna", q_tna},
+    {"ppo", q_ppo}, {"plv", q_plv}, {"pin", q_pin}, {"sgt", q_sgt},
+    {"sst", q_sst},
+};
+
+void gui_command(net_t *net, player_t *gui, const char *line)
+{
+    size_t len = strcspn(line, " ");
+    const char *args = line[len] ? line + len + 1 : line + len;
+
+    for (size_t i = 0; i < sizeof(QUERIES) / sizeof(*QUERIES); ++i) {
+        if (strlen(QUERIES[i].name) != len ||
+            strncmp(line, QUERIES[i].name, len))
+            continue;
+        if (!QUERIES[i].fn(net, gui, args))
+            sock_printf(&gui->out, "sbp\n");
+        return;
+    }
+    sock_printf(&gui->out, "suc\n");
+}
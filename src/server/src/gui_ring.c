@@ -0,0 +1,134 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** gui_ring.c - shared-memory GUI feed for co-located viewers
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "gui_ring.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static size_t round_pow2(size_t n)
+{
+    size_t cap = GUI_RING_MIN_CAP;
+
+    while (cap < n)
+        cap <<= 1;
+    return cap;
+}
+
+static char *ring_name(const char *name)
+{
+    size_t len = strlen(name);
+    char *out = malloc(len + 2);
+
+    if (!out)
+        return NULL;
+    out[0] = '/';
+    memcpy(out + 1, name + (name[0] == '/'), len + 1 - (name[0] == '/'));
+    return out;
+}
+
+static bool ring_map(gui_ring_t *ring, size_t cap, size_t kf_cap)
+{
+    int fd;
+    void *mem;
+
+    shm_unlink(ring->name);
+    fd = shm_open(ring->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        return false;
+    ring->map_len = GUI_RING_HDR_SZ + cap + 2 * kf_cap;
+    if (ftruncate(fd, (off_t)ring->map_len) < 0) {
+        close(fd);
+        return false;
+    }
+    mem = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+        return false;
+    ring->hdr = mem;
+    ring->data = (char *)mem + GUI_RING_HDR_SZ;
+    return true;
+}
+
+gui_ring_t *gui_ring_open(const char *name, size_t kf_cap)
+{
+    gui_ring_t *ring = calloc(1, sizeof(*ring));
+    size_t cap = round_pow2(4 * kf_cap);
+
+    if (!ring)
+        return NULL;
+    ring->name = ring_name(name);
+    if (!ring->name || !ring_map(ring, cap, kf_cap)) {
+        free(ring->name);
+        free(ring);
+        return NULL;
+    }
+    ring->hdr->version = GUI_RING_VERSION;
+    ring->hdr->capacity = cap;
+    ring->hdr->kf_capacity = kf_cap;
+    atomic_store_explicit(&ring->hdr->magic, GUI_RING_MAGIC,
+        memory_order_release);
+    return ring;
+}
+
+/* Seqlock-style publish: announce the overwrite, copy, then expose */
+void gui_ring_write(gui_ring_t *ring, const char *msg, size_t n)
+{
+    uint64_t cap;
+    size_t pos;
+    size_t first;
+
+    if (!ring || n == 0 || n > ring->hdr->kf_capacity)
+        return;
+    cap = ring->hdr->capacity;
+    pos = (size_t)(ring->head & (cap - 1));
+    first = (n < cap - pos) ? n : (size_t)(cap - pos);
+    atomic_store_explicit(&ring->hdr->reserve, ring->head + n,
+        memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(ring->data + pos, msg, first);
+    memcpy(ring->data, msg + first, n - first);
+    ring->head += n;
+    atomic_store_explicit(&ring->hdr->head, ring->head,
+        memory_order_release);
+}
+
+/* Double-buffered: the slot being written is never the latest published */
+void gui_ring_write_keyframe(gui_ring_t *ring, const char *msg, size_t n)
+{
+    gui_ring_hdr_t *hdr;
+    uint64_t seq;
+    int slot;
+
+    if (!ring || n == 0 || n > ring->hdr->kf_capacity)
+        return;
+    hdr = ring->hdr;
+    seq = atomic_load_explicit(&hdr->kf_seq, memory_order_relaxed) + 1;
+    slot = (int)(seq & 1);
+    atomic_store_explicit(&hdr->kf_reserve, seq, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    hdr->kf_at[slot] = ring->head;
+    hdr->kf_len[slot] = n;
+    memcpy(ring->data + hdr->capacity + (size_t)slot * hdr->kf_capacity,
+        msg, n);
+    atomic_store_explicit(&hdr->kf_seq, seq, memory_order_release);
+}
+
+void gui_ring_close(gui_ring_t *ring)
+{
+    if (!ring)
+        return;
+    munmap(ring->hdr, ring->map_len);
+    shm_unlink(ring->name);
+    outbuf_free(&ring->scratch);
+    free(ring->name);
+    free(ring);
+}
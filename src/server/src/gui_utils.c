@@ -6,30 +6,113 @@
 */
 
 #include "gui.h"
+#include "gui_ring.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <unistd.h>
 
-void sock_printf(int fd, const char *fmt, ...)
+/* A line longer than the stack buffer is formatted again, in place */
+static bool append_long(outbuf_t *ob, size_t n, const char *fmt, va_list ap)
+{
+    if (!outbuf_reserve(ob, n + 1))
+        return false;
+    vsnprintf(ob->data + ob->len, n + 1, fmt, ap);
+    ob->len += n;
+    return true;
+}
+
+bool sock_printf(outbuf_t *ob, const char *fmt, ...)
+{
+    char buf[GUI_BUF_SZ];
+    va_list ap;
+    va_list again;
+    int n;
+    bool ok;
+
+    va_start(ap, fmt);
+    va_copy(again, ap);
+    n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n > 0 && (size_t)n >= sizeof(buf))
+        ok = append_long(ob, (size_t)n, fmt, again);
+    else
+        ok = n <= 0 || outbuf_append(ob, buf, (size_t)n);
+    va_end(again);
+    return ok;
+}
+
+void broadcast_printf(net_t *net, const char *fmt, ...)
 {
     char buf[GUI_BUF_SZ];
+    char *line = buf;
     va_list ap;
+    va_list again;
     int n;
 
     va_start(ap, fmt);
+    va_copy(again, ap);
     n = vsnprintf(buf, sizeof(buf), fmt, ap);
     va_end(ap);
-    if (n > 0)
-        write(fd, buf, (size_t)n);
+    if (n > 0 && (size_t)n >= sizeof(buf)) {
+        line = arena_alloc(&net->tick, (size_t)n + 1);
+        if (line)
+            vsnprintf(line, (size_t)n + 1, fmt, again);
+    }
+    va_end(again);
+    if (n > 0 && line)
+        broadcast(net, line, (size_t)n);
+}
+
+/* The limit leaves room for one full snapshot on top of the delta budget */
+static size_t backlog_limit(const net_t *net)
+{
+    return GUI_OUTQ_MAX +
+        (size_t)net->world->w * (size_t)net->world->h * GUI_TILE_BYTES;
+}
+
+static void gui_resync(net_t *net, player_t *gui)
+{
+    if (gui->resync_pending) {
+        gui->doomed = true;
+        return;
+    }
+    outbuf_drop_pending(&gui->out);
+    gui->resync_pending = true;
+    metrics_add(&net->metrics, M_GUI_RESYNCS, 1);
+    gui_send_initial(net, gui);
+}
+
+void gui_send(net_t *net, player_t *gui, const char *msg, size_t n)
+{
+    if (gui->doomed)
+        return;
+    if (outbuf_pending(&gui->out) + n > backlog_limit(net))
+        gui_resync(net, gui);
+    if (!gui->doomed && !outbuf_append(&gui->out, msg, n))
+        gui->doomed = true;
 }
 
 void broadcast(net_t *net, const char *msg, size_t n)
 {
     player_t *pl;
 
-    for (int i = 1; i < net->nfds; ++i) {
+    gui_ring_write(net->ring, msg, n);
+    metrics_add(&net->metrics, M_GUI_BYTES, n);
+    for (int i = net->nlisten; i < net->nfds; ++i) {
         pl = (player_t *)net->players[i];
         if (IS_GUI(pl))
-            write(net->pfds[i].fd, msg, n);
+            gui_send(net, pl, msg, n);
     }
 }
+
+void gui_ring_keyframe(net_t *net)
+{
+    gui_ring_t *ring = net->ring;
+
+    if (!ring)
+        return;
+    ring->scratch.off = 0;
+    ring->scratch.len = 0;
+    if (gui_build_snapshot(net, &ring->scratch))
+        gui_ring_write_keyframe(ring, ring->scratch.data, ring->scratch.len);
+}
@@ -9,6 +9,7 @@
 #include "player.h"
 #include "net_client.h"
 #include "gui.h"
+#include "journal.h"
 
 static void starve_player(net_t *net, int idx)
 {
@@ -16,8 +17,10 @@ static void starve_player(net_t *net, int idx)
 
     if (!pl)
         return;
-    write(pl->fd, "dead\n", 5);
+    player_send(pl, "dead\n", 5);
+    player_flush(pl);
     gui_broadcast_pdi(net, pl);
+    journal_event(net->world->journal, J_DEATH, (uint64_t[]){pl->id}, 1);
     drop_fd(net, idx);
 }
 
@@ -36,6 +39,8 @@ static void update_player_hunger(net_t *net, int idx, uint64_t now,
         pl->inv[RES_FOOD] -= (uint16_t)ticks;
         pl->next_food += period * ticks;
         gui_broadcast_pin(net, pl);
+        journal_event(net->world->journal, J_EAT,
+            (uint64_t[]){pl->id, ticks}, 2);
     } else {
         starve_player(net, idx);
     }
@@ -46,6 +51,19 @@ void hunger_check(net_t *net, uint64_t now)
     uint64_t period = 126000ULL / (uint64_t)net->freq;
     int i;
 
-    for (i = 1; i < net->nfds; ++i)
+    for (i = net->nlisten; i < net->nfds; ++i)
         update_player_hunger(net, i, now, period);
 }
+
+uint64_t hunger_next_due(const net_t *net)
+{
+    uint64_t due = UINT64_MAX;
+    const player_t *pl;
+
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        pl = (const player_t *)net->players[i];
+        if (pl && pl->authed && pl->team_idx >= 0 && pl->next_food < due)
+            due = pl->next_food;
+    }
+    return due;
+}
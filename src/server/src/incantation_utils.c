@@ -6,34 +6,11 @@
 */
 
 #include "incantation_utils.h"
-#include <sys/time.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
 #include "gui.h"
-
-uint64_t inc_now_ms(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
-
-int inc_count_players(const net_t *net, int x, int y, int lvl)
-{
-    int cnt = 0;
-    const player_t *p;
-
-    for (int i = 1; i < net->nfds; ++i) {
-        p = (const player_t *)net->players[i];
-        if (!p || !p->authed || p->team_idx < 0)
-            continue;
-        if (p->x == x && p->y == y && p->level == lvl)
-            ++cnt;
-    }
-    return cnt;
-}
+#include "journal.h"
 
 bool inc_resources_sufficient(const tile_t *t, const int stones[RES_MAX])
 {
@@ -44,10 +21,10 @@ bool inc_resources_sufficient(const tile_t *t, const int stones[RES_MAX])
     return true;
 }
 
-void inc_consume_resources(tile_t *t, const int stones[RES_MAX])
+void inc_consume_resources(world_t *w, tile_t *t, const int stones[RES_MAX])
 {
     for (res_t id = 0; id < RES_MAX; ++id)
-        t->res[id] -= (uint16_t)stones[id];
+        tile_res_take(w, t, id, (unsigned)stones[id]);
 }
 
 static void inc_send_level_msg(player_t *pl)
@@ -57,22 +34,18 @@ static void inc_send_level_msg(player_t *pl)
         "Current level: %d\n", pl->level);
 
     if (n > 0)
-        write(pl->fd, buf, (size_t)n);
-    if (pl->q_len > 0)
-        --pl->q_len;
+        player_send(pl, buf, (size_t)n);
 }
 
-void inc_level_up_players(net_t *net, int x, int y, int lvl)
+void inc_level_up_players(net_t *net, const ritual_t *r)
 {
-    player_t *pl;
-
-    for (int i = 1; i < net->nfds; ++i) {
-        pl = (player_t *)net->players[i];
-        if (!pl || pl->level != lvl ||
-            pl->x != x || pl->y != y)
+    for (player_t *pl = r->first; pl; pl = pl->ritual_next) {
+        if (!ritual_in_place(r, pl))
             continue;
         pl->level += 1;
         inc_send_level_msg(pl);
         gui_broadcast_plv(net, pl);
+        journal_event(net->world->journal, J_LEVEL,
+            (uint64_t[]){pl->id, (uint64_t)pl->level}, 2);
     }
 }
@@ -7,24 +7,15 @@
 
 #include "item_helpers.h"
 #include "gui.h"
-#include <sys/time.h>
 
 static const char *RES_NAMES[RES_MAX] = {
     "food", "linemate", "deraumere", "sibur",
     "mendiane", "phiras", "thystame"
 };
 
-uint64_t ih_now_ms(void)
+void ih_reply(player_t *p, const char *msg)
 {
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
-
-void ih_reply(int fd, const char *msg)
-{
-    write(fd, msg, strlen(msg));
+    player_send(p, msg, strlen(msg));
 }
 
 bool ih_res_from_string(const char *word, res_t *out)
@@ -40,18 +31,16 @@ bool ih_res_from_string(const char *word, res_t *out)
 
 bool ih_perform_take(player_t *p, res_t id, tile_t *t)
 {
-    if (t->res[id] == 0)
+    if (p->inv[id] == UINT16_MAX || !tile_res_take(p->world, t, id, 1))
         return false;
-    --t->res[id];
     ++p->inv[id];
     return true;
 }
 
 bool ih_perform_set(player_t *p, res_t id, tile_t *t)
 {
-    if (p->inv[id] == 0)
+    if (p->inv[id] == 0 || !tile_res_add(p->world, t, id, 1))
         return false;
     --p->inv[id];
-    ++t->res[id];
     return true;
 }
@@ -0,0 +1,71 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** journal.c - buffered append-only match journal
+*/
+
+#include "journal.h"
+#include "clock.h"
+#include "player.h"
+
+/* Unsigned LEB128: seven bits per byte, high bit set while more follow */
+void journal_varint(journal_t *j, uint64_t v)
+{
+    char tmp[10];
+    size_t n = 0;
+
+    while (v >= 0x80) {
+        tmp[n++] = (char)(v | 0x80);
+        v >>= 7;
+    }
+    tmp[n++] = (char)v;
+    if (!outbuf_append(&j->buf, tmp, n))
+        j->failed = true;
+}
+
+/* The file is blocking: a flush writes everything or fails for good */
+void journal_write_pending(journal_t *j)
+{
+    j->since_keyframe += outbuf_pending(&j->buf);
+    if (!j->failed && !outbuf_flush(&j->buf, j->fd, NULL))
+        j->failed = true;
+    outbuf_recycle(&j->buf, 2 * JOURNAL_FLUSH_AT);
+}
+
+bool journal_record(journal_t *j, jrec_t type)
+{
+    uint64_t now = clock_now_ms();
+    char byte = (char)type;
+
+    if (!j || j->failed)
+        return false;
+    if (outbuf_pending(&j->buf) >= JOURNAL_FLUSH_AT)
+        journal_write_pending(j);
+    if (!outbuf_append(&j->buf, &byte, 1))
+        j->failed = true;
+    journal_varint(j, now > j->last_ms ? now - j->last_ms : 0);
+    j->last_ms = now > j->last_ms ? now : j->last_ms;
+    return !j->failed;
+}
+
+void journal_event(journal_t *j, jrec_t type, const uint64_t *fields,
+    size_t n)
+{
+    if (journal_record(j, type))
+        journal_fields(j, fields, n);
+}
+
+void journal_player(journal_t *j, jrec_t type, const player_t *pl)
+{
+    if (!journal_record(j, type))
+        return;
+    journal_fields(j, (uint64_t[]){pl->id, (uint64_t)pl->x, (uint64_t)pl->y,
+        (uint64_t)pl->dir + 1}, 4);
+    if (type != J_SPAWN)
+        return;
+    journal_fields(j, (uint64_t[]){(uint64_t)pl->level,
+        (uint64_t)pl->team_idx}, 2);
+    for (int r = 0; r < RES_MAX; ++r)
+        journal_varint(j, pl->inv[r]);
+}
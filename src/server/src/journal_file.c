@@ -0,0 +1,88 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** journal_file.c - journal creation, header and shutdown
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "journal.h"
+#include "clock.h"
+#include "net_poll.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void journal_fields(journal_t *j, const uint64_t *fields, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        journal_varint(j, fields[i]);
+}
+
+void journal_broadcast(journal_t *j, uint32_t id, const char *text)
+{
+    size_t len = strlen(text);
+
+    if (!journal_record(j, J_BROADCAST))
+        return;
+    journal_varint(j, id);
+    journal_varint(j, len);
+    if (!outbuf_append(&j->buf, text, len))
+        j->failed = true;
+}
+
+static void journal_header(journal_t *j, const net_t *net)
+{
+    const world_t *w = net->world;
+
+    if (!outbuf_append(&j->buf, JOURNAL_MAGIC, 4))
+        j->failed = true;
+    journal_varint(j, JOURNAL_VERSION);
+    journal_varint(j, (uint64_t)w->w);
+    journal_varint(j, (uint64_t)w->h);
+    journal_varint(j, (uint64_t)net->freq);
+    journal_varint(j, w->seed);
+    journal_varint(j, j->last_ms);
+    journal_varint(j, (uint64_t)net->team_cnt);
+    for (int i = 0; i < net->team_cnt; ++i) {
+        journal_varint(j, net->teams[i].name_len);
+        if (!outbuf_append(&j->buf, net->teams[i].name,
+            net->teams[i].name_len))
+            j->failed = true;
+    }
+}
+
+journal_t *journal_open(const char *path, const net_t *net)
+{
+    journal_t *j = calloc(1, sizeof(*j));
+    if (!j)
+        return NULL;
+    j->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (j->fd < 0 || !outbuf_init(&j->buf, 2 * JOURNAL_FLUSH_AT)) {
+        journal_close(j);
+        return NULL;
+    }
+    j->last_ms = clock_now_ms();
+    journal_header(j, net);
+    journal_keyframe(j, net);
+    journal_write_pending(j);
+    if (j->failed) {
+        journal_close(j);
+        return NULL;
+    }
+    return j;
+}
+
+void journal_close(journal_t *j)
+{
+    if (!j)
+        return;
+    if (j->fd >= 0) {
+        journal_write_pending(j);
+        close(j->fd);
+    }
+    outbuf_free(&j->buf);
+    free(j);
+}
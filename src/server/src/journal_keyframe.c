@@ -0,0 +1,83 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** journal_keyframe.c - full snapshots written into the journal
+*/
+
+#include "journal.h"
+#include "net_poll.h"
+
+static void keyframe_tiles(journal_t *j, const world_t *w)
+{
+    const tile_t *t;
+
+    for (int y = 0; y < w->h; ++y) {
+        for (int x = 0; x < w->w; ++x) {
+            t = world_peek_tile(w, x, y);
+            for (int r = 0; r < RES_MAX; ++r)
+                journal_varint(j, t->res[r]);
+        }
+    }
+}
+
+static void keyframe_players(journal_t *j, const net_t *net)
+{
+    const player_t *pl;
+    uint64_t count = 0;
+
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        pl = (const player_t *)net->players[i];
+        count += pl && pl->authed && pl->team_idx >= 0;
+    }
+    journal_varint(j, count);
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        pl = (const player_t *)net->players[i];
+        if (!pl || !pl->authed || pl->team_idx < 0)
+            continue;
+        journal_fields(j, (uint64_t[]){pl->id, (uint64_t)pl->x,
+            (uint64_t)pl->y, (uint64_t)pl->dir + 1, (uint64_t)pl->level,
+            (uint64_t)pl->team_idx}, 6);
+        for (int r = 0; r < RES_MAX; ++r)
+            journal_varint(j, pl->inv[r]);
+    }
+}
+
+static void keyframe_eggs(journal_t *j, const net_t *net)
+{
+    const egg_pool_t *pool = &net->eggs;
+    const egg_t *e;
+
+    journal_varint(j, (uint64_t)pool->count);
+    for (int team = 0; team < net->team_cnt; ++team) {
+        for (int i = pool->team_head[team]; i >= 0;
+            i = e->link[EGG_BY_TEAM].next) {
+            e = &pool->eggs[i];
+            journal_fields(j, (uint64_t[]){(uint64_t)e->id,
+                (uint64_t)e->x, (uint64_t)e->y, (uint64_t)e->team_idx}, 4);
+        }
+    }
+}
+
+/* Flushed on both sides so since_keyframe only counts the deltas */
+void journal_keyframe(journal_t *j, const net_t *net)
+{
+    if (!j || j->failed)
+        return;
+    journal_write_pending(j);
+    if (!journal_record(j, J_KEYFRAME))
+        return;
+    journal_varint(j, (uint64_t)net->freq);
+    keyframe_tiles(j, net->world);
+    keyframe_players(j, net);
+    keyframe_eggs(j, net);
+    journal_write_pending(j);
+    j->since_keyframe = 0;
+}
+
+void journal_maybe_keyframe(journal_t *j, const net_t *net)
+{
+    if (j && j->since_keyframe + outbuf_pending(&j->buf) >=
+        JOURNAL_KEYFRAME_BYTES)
+        journal_keyframe(j, net);
+}
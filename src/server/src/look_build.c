@@ -6,16 +6,19 @@
 */
 
 #include "command_look.h"
-#include "player.h"
 #include "world.h"
 #include "net_poll.h"
+#include <stdlib.h>
 #include <string.h>
 
-static const char *RES_NAMES[RES_MAX] = {
-    "food", "linemate", "deraumere", "sibur",
-    "mendiane", "phiras", "thystame"
+/* Each word carries its trailing space, the last one is trimmed per tile */
+static const token_t RES_WORDS[RES_MAX] = {
+    TOKEN("food "), TOKEN("linemate "), TOKEN("deraumere "), TOKEN("sibur "),
+    TOKEN("mendiane "), TOKEN("phiras "), TOKEN("thystame ")
 };
 
+static const token_t PLAYER_WORD = TOKEN("player ");
+
 int wrap_coord(int v, int max)
 {
     v %= max;
@@ -24,66 +27,58 @@ int wrap_coord(int v, int max)
     return v;
 }
 
-static size_t add_word(buf_ctx_t *b, const char *word)
-{
-    size_t used = 0;
-
-    if (!b || !b->rem)
-        return 0;
-    if (*b->need_sp && b->rem) {
-        *(b->dst) = ' ';
-        b->dst += 1;
-        used += 1;
-        b->rem -= 1;
-    }
-    while (*word && b->rem) {
-        *(b->dst) = *word;
-        b->dst += 1;
-        used += 1;
-        word += 1;
-        b->rem -= 1;
-    }
-    *b->need_sp = true;
-    return used;
-}
-
-static size_t add_players(const net_t *net, int x, int y,
-    buf_ctx_t *b)
+static bool add_words(outbuf_t *out, token_t word, size_t count)
 {
-    size_t used = 0;
-    int idx;
-    player_t *p;
+    char *dst;
 
-    for (idx = 1; idx < net->nfds && used < b->rem; ++idx) {
-        p = (player_t *)net->players[idx];
-        if (!p || !p->authed || p->team_idx < 0)
-            continue;
-        if (p->x == x && p->y == y)
-            used += add_word(b, "player");
+    if (!count)
+        return true;
+    if (!outbuf_reserve(out, word.len * count))
+        return false;
+    dst = out->data + out->len;
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(dst, word.str, word.len);
+        dst += word.len;
     }
-    return used;
+    out->len += word.len * count;
+    return true;
 }
 
-static size_t add_resources(const tile_t *t, buf_ctx_t *b)
+static bool refresh_frag(const tile_t *t, tile_frag_t *f)
 {
-    size_t used = 0;
-    res_t r;
-    uint16_t c;
+    bool ok;
 
-    for (r = 0; r < RES_MAX && used < b->rem; ++r)
-        for (c = 0; c < t->res[r] && used < b->rem; ++c)
-            used += add_word(b, RES_NAMES[r]);
-    return used;
+    f->text.off = 0;
+    f->text.len = 0;
+    f->valid = false;
+    ok = add_words(&f->text, PLAYER_WORD, t->players);
+    for (res_t r = 0; r < RES_MAX && ok; ++r)
+        ok = add_words(&f->text, RES_WORDS[r], t->res[r]);
+    if (!ok)
+        return false;
+    if (f->text.len)
+        f->text.len--;
+    f->version = t->version;
+    f->valid = true;
+    return true;
 }
 
-size_t build_tile(const net_t *net, int x, int y, buf_ctx_t *b)
+bool build_tile(const net_t *net, int x, int y, outbuf_t *out)
 {
-    bool need = false;
-    size_t used;
+    chunk_t *c = world_chunk(net->world, x, y);
+    size_t idx = world_chunk_slot(x, y);
+    const tile_t *t;
+    tile_frag_t *f;
 
-    b->need_sp = &need;
-    used = add_players(net, x, y, b);
-    used += add_resources(&net->world->tiles[y * net->world->w + x], b);
-    *b->need_sp = true;
-    return used;
+    if (!c)
+        return true;
+    if (!c->frags)
+        c->frags = calloc(WORLD_CHUNK_TILES, sizeof(tile_frag_t));
+    if (!c->frags)
+        return false;
+    t = &c->tiles[idx];
+    f = &c->frags[idx];
+    if ((!f->valid || f->version != t->version) && !refresh_frag(t, f))
+        return false;
+    return outbuf_append(out, f->text.data, f->text.len);
 }
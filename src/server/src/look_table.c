@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** look_table.c - relative tile offsets of the Look cone
+*/
+
+#include "look_table.h"
+
+/*
+** Row d lists the cone of a player facing orientation d, in Look order:
+** distance 0 to 8, then left to right. Level l reads the first
+** LOOK_TILES(l) entries. Generated from dir 0 = (off, -dist) rotated
+** clockwise; keep in sync with the protocol if the cone ever changes.
+*/
+const look_off_t LOOK_TABLE[4][LOOK_TILES(LOOK_MAX_LEVEL)] = {
+    /* North */
+    {
+        {0, 0}, {-1, -1}, {0, -1}, {1, -1}, {-2, -2}, {-1, -2}, {0, -2},
+        {1, -2}, {2, -2}, {-3, -3}, {-2, -3}, {-1, -3}, {0, -3}, {1, -3},
+        {2, -3}, {3, -3}, {-4, -4}, {-3, -4}, {-2, -4}, {-1, -4}, {0, -4},
+        {1, -4}, {2, -4}, {3, -4}, {4, -4}, {-5, -5}, {-4, -5}, {-3, -5},
+        {-2, -5}, {-1, -5}, {0, -5}, {1, -5}, {2, -5}, {3, -5}, {4, -5},
+        {5, -5}, {-6, -6}, {-5, -6}, {-4, -6}, {-3, -6}, {-2, -6}, {-1, -6},
+        {0, -6}, {1, -6}, {2, -6}, {3, -6}, {4, -6}, {5, -6}, {6, -6},
+        {-7, -7}, {-6, -7}, {-5, -7}, {-4, -7}, {-3, -7}, {-2, -7}, {-1, -7},
+        {0, -7}, {1, -7}, {2, -7}, {3, -7}, {4, -7}, {5, -7}, {6, -7},
+        {7, -7}, {-8, -8}, {-7, -8}, {-6, -8}, {-5, -8}, {-4, -8}, {-3, -8},
+        {-2, -8}, {-1, -8}, {0, -8}, {1, -8}, {2, -8}, {3, -8}, {4, -8},
+        {5, -8}, {6, -8}, {7, -8}, {8, -8}
+    },
+    /* East */
+    {
+        {0, 0}, {1, -1}, {1, 0}, {1, 1}, {2, -2}, {2, -1}, {2, 0}, {2, 1},
+        {2, 2}, {3, -3}, {3, -2}, {3, -1}, {3, 0}, {3, 1}, {3, 2}, {3, 3},
+        {4, -4}, {4, -3}, {4, -2}, {4, -1}, {4, 0}, {4, 1}, {4, 2}, {4, 3},
+        {4, 4}, {5, -5}, {5, -4}, {5, -3}, {5, -2}, {5, -1}, {5, 0}, {5, 1},
+        {5, 2}, {5, 3}, {5, 4}, {5, 5}, {6, -6}, {6, -5}, {6, -4}, {6, -3},
+        {6, -2}, {6, -1}, {6, 0}, {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5},
+        {6, 6}, {7, -7}, {7, -6}, {7, -5}, {7, -4}, {7, -3}, {7, -2},
+        {7, -1}, {7, 0}, {7, 1}, {7, 2}, {7, 3}, {7, 4}, {7, 5}, {7, 6},
+        {7, 7}, {8, -8}, {8, -7}, {8, -6}, {8, -5}, {8, -4}, {8, -3},
+        {8, -2}, {8, -1}, {8, 0}, {8, 1}, {8, 2}, {8, 3}, {8, 4}, {8, 5},
+        {8, 6}, {8, 7}, {8, 8}
+    },
+    /* South */
+    {
+        {0, 0}, {1, 1}, {0, 1}, {-1, 1}, {2, 2}, {1, 2}, {0, 2}, {-1, 2},
+        {-2, 2}, {3, 3}, {2, 3}, {1, 3}, {0, 3}, {-1, 3}, {-2, 3}, {-3, 3},
+        {4, 4}, {3, 4}, {2, 4}, {1, 4}, {0, 4}, {-1, 4}, {-2, 4}, {-3, 4},
+        {-4, 4}, {5, 5}, {4, 5}, {3, 5}, {2, 5}, {1, 5}, {0, 5}, {-1, 5},
+        {-2, 5}, {-3, 5}, {-4, 5}, {-5, 5}, {6, 6}, {5, 6}, {4, 6}, {3, 6},
+        {2, 6}, {1, 6}, {0, 6}, {-1, 6}, {-2, 6}, {-3, 6}, {-4, 6}, {-5, 6},
+        {-6, 6}, {7, 7}, {6, 7}, {5, 7}, {4, 7}, {3, 7}, {2, 7}, {1, 7},
+        {0, 7}, {-1, 7}, {-2, 7}, {-3, 7}, {-4, 7}, {-5, 7}, {-6, 7},
+        {-7, 7}, {8, 8}, {7, 8}, {6, 8}, {5, 8}, {4, 8}, {3, 8}, {2, 8},
+        {1, 8}, {0, 8}, {-1, 8}, {-2, 8}, {-3, 8}, {-4, 8}, {-5, 8}, {-6, 8},
+        {-7, 8}, {-8, 8}
+    },
+    /* West */
+    {
+        {0, 0}, {-1, 1}, {-1, 0}, {-1, -1}, {-2, 2}, {-2, 1}, {-2, 0},
+        {-2, -1}, {-2, -2}, {-3, 3}, {-3, 2}, {-3, 1}, {-3, 0}, {-3, -1},
+        {-3, -2}, {-3, -3}, {-4, 4}, {-4, 3}, {-4, 2}, {-4, 1}, {-4, 0},
+        {-4, -1}, {-4, -2}, {-4, -3}, {-4, -4}, {-5, 5}, {-5, 4}, {-5, 3},
+        {-5, 2}, {-5, 1}, {-5, 0}, {-5, -1}, {-5, -2}, {-5, -3}, {-5, -4},
+        {-5, -5}, {-6, 6}, {-6, 5}, {-6, 4}, {-6, 3}, {-6, 2}, {-6, 1},
+        {-6, 0}, {-6, -1}, {-6, -2}, {-6, -3}, {-6, -4}, {-6, -5}, {-6, -6},
+        {-7, 7}, {-7, 6}, {-7, 5}, {-7, 4}, {-7, 3}, {-7, 2}, {-7, 1},
+        {-7, 0}, {-7, -1}, {-7, -2}, {-7, -3}, {-7, -4}, {-7, -5}, {-7, -6},
+        {-7, -7}, {-8, 8}, {-8, 7}, {-8, 6}, {-8, 5}, {-8, 4}, {-8, 3},
+        {-8, 2}, {-8, 1}, {-8, 0}, {-8, -1}, {-8, -2}, {-8, -3}, {-8, -4},
+        {-8, -5}, {-8, -6}, {-8, -7}, {-8, -8}
+    }
+};
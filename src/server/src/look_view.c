@@ -9,74 +9,46 @@
 #include "player.h"
 #include "world.h"
 #include "net_poll.h"
+#include "look_table.h"
 
-void coord_for_dir(const player_t *pl, int dist, int off,
-    pos_t *pos)
-{
-    switch (pl->dir) {
-    case 0:
-        pos->x = pl->x + off;
-        pos->y = pl->y - dist;
-        break;
-    case 1:
-        pos->x = pl->x + dist;
-        pos->y = pl->y + off;
-        break;
-    case 2:
-        pos->x = pl->x - off;
-        pos->y = pl->y + dist;
-        break;
-    default:
-        pos->x = pl->x - dist;
-        pos->y = pl->y - off;
-        break;
-    }
-}
+static const token_t TILE_SEP = TOKEN(", ");
 
-static void write_sep(view_ctx_t *v)
+void append_tile(const player_t *pl, int tx, int ty, view_ctx_t *v)
 {
-    size_t pos;
-
-    if (*v->first || *v->len + 2 >= v->size)
-        return;
-    pos = *v->len;
-    v->buf[pos] = ',';
-    pos++;
-    v->buf[pos] = ' ';
-    pos++;
-    *v->len = pos;
+    if (!v->first)
+        v->ok = outbuf_append(v->out, TILE_SEP.str, TILE_SEP.len);
+    v->first = false;
+    v->ok = v->ok && build_tile(pl->net, tx, ty, v->out);
 }
 
-void append_tile(const player_t *pl, int tx, int ty, view_ctx_t *v)
+static void look_far(const player_t *pl, const look_off_t *cone,
+    int n, view_ctx_t *v)
 {
-    buf_ctx_t b;
+    const world_t *w = pl->world;
 
-    write_sep(v);
-    *v->first = false;
-    b.dst = v->buf + *v->len;
-    b.rem = v->size - *v->len;
-    b.need_sp = NULL;
-    *v->len += build_tile(pl->net, tx, ty, &b);
+    for (int i = 0; i < n && v->ok; ++i)
+        append_tile(pl, look_wrap_near(pl->x + cone[i].dx, w->w),
+            look_wrap_near(pl->y + cone[i].dy, w->h), v);
 }
 
-void add_line(const player_t *pl, int dist, view_ctx_t *v)
+/* Maps narrower than the cone may wrap several times: use the modulo */
+static void look_near(const player_t *pl, const look_off_t *cone,
+    int n, view_ctx_t *v)
 {
     const world_t *w = pl->world;
-    int off;
-    pos_t coord;
 
-    for (off = -dist; off <= dist && *v->len < v->size; ++off) {
-        coord_for_dir(pl, dist, off, &coord);
-        coord.x = wrap_coord(coord.x, w->w);
-        coord.y = wrap_coord(coord.y, w->h);
-        append_tile(pl, coord.x, coord.y, v);
-    }
+    for (int i = 0; i < n && v->ok; ++i)
+        append_tile(pl, wrap_coord(pl->x + cone[i].dx, w->w),
+            wrap_coord(pl->y + cone[i].dy, w->h), v);
 }
 
 void traverse_view(const player_t *pl, view_ctx_t *v)
 {
-    int dist;
+    int level = pl->level < LOOK_MAX_LEVEL ? pl->level : LOOK_MAX_LEVEL;
+    const look_off_t *cone = LOOK_TABLE[pl->dir & 3];
 
-    for (dist = 0; dist <= pl->level && *v->len < v->size; ++dist)
-        add_line(pl, dist, v);
+    if (pl->world->w >= LOOK_MAX_LEVEL && pl->world->h >= LOOK_MAX_LEVEL)
+        look_far(pl, cone, LOOK_TILES(level), v);
+    else
+        look_near(pl, cone, LOOK_TILES(level), v);
 }
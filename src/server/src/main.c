@@ -5,12 +5,15 @@
 ** main
 */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/time.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <signal.h>
 #include "cfg.h"
+#include "clock.h"
 #include "world.h"
 #include "net_poll.h"
 #include "scheduler.h"
@@ -19,19 +22,35 @@
 #include "net_client.h"
 #include "player.h"
 #include "hunger.h"
+#include "journal.h"
+#include "trace.h"
+
+static volatile sig_atomic_t g_stop = 0;
+
+static void on_stop_signal(int sig)
+{
+    (void)sig;
+    g_stop = 1;
+}
 
-static uint64_t now_ms(void)
+/* No SA_RESTART: the signal interrupts poll and the loop exits right away */
+static void install_stop_handlers(void)
 {
-    struct timeval tv;
+    struct sigaction sa = {0};
 
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
+    sa.sa_handler = on_stop_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
 }
 
 static void print_usage(const char *prog)
 {
     printf("USAGE: %s -p port -x width -y height -n name1 name2"
-        " -c clientsNb -f freq\n", prog);
+        " -c clientsNb -f freq [-r acceptors] [-u unix_socket_path]"
+        " [-m shm_name] [-s seed] [-a admin_port|admin_socket]"
+        " [-j journal_path] [-t trace_path [-o output_path]]\n", prog);
 }
 
 static int cleanup_world_teams(world_t *world, team_t *teams, const char *msg)
@@ -49,24 +68,28 @@ static void run_loop(net_t *net, scheduler_t *sched)
     int poll_timeout;
     uint64_t next_event;
 
-    while (1) {
-        now = now_ms();
+    while (!g_stop) {
+        now = clock_now_ms();
         next_event = scheduler_time_until_next(sched, now);
         poll_timeout = (next_event > 50) ? 50 : (int)next_event;
         net_poll_once(net, poll_timeout);
-        now = now_ms();
+        now = clock_now_ms();
         hunger_check(net, now);
         scheduler_run_ready(sched, now);
+        net_flush_all(net);
+        arena_reset(&net->tick);
+        metrics_loop(&net->metrics, metrics_now_us() - net->woke_us);
     }
 }
 
 void schedule_periodic_refill(net_t *net, scheduler_t *sched)
 {
     action_t act = {0};
-    uint64_t now = now_ms();
+    uint64_t now = clock_now_ms();
     uint64_t period = 20000ULL / (uint64_t)net->freq;
 
-    act.exec_at = now + period;
+    /* -f is not capped like sst: never re-arm for the current ms */
+    act.exec_at = now + (period ? period : 1);
     act.fn = exec_periodic_refill;
     act.pl = (player_t *)net;
     scheduler_push(sched, act);
@@ -80,9 +103,27 @@ void exec_periodic_refill(struct s_player *raw)
         return;
     world_periodic_refill(net->world);
     gui_broadcast_full_map(net);
+    gui_ring_keyframe(net);
+    journal_maybe_keyframe(net->world->journal, net);
     schedule_periodic_refill(net, net->sched);
 }
 
+static int open_recordings(const cfg_t *cfg, server_components_t *components)
+{
+    if (cfg->journal) {
+        components->world->journal = journal_open(cfg->journal,
+            components->net);
+        if (!components->world->journal)
+            return EXIT_FAILURE;
+    }
+    if (cfg->trace) {
+        components->net->trace = trace_open(cfg->trace, cfg->trace_out);
+        if (!components->net->trace)
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
 static int init_server_components(const cfg_t *cfg,
     server_components_t *components)
 {
@@ -98,15 +139,41 @@ static int init_server_components(const cfg_t *cfg,
         cfg->team_count, cfg->teams, cfg->clients_nb);
     np = (net_params_t){.port = cfg->port, .world = components->world,
         .teams = *components->teams, .team_cnt = cfg->team_count,
-        .sched = components->sched, .freq = cfg->freq};
+        .sched = components->sched, .freq = cfg->freq,
+        .unix_path = cfg->unix_path, .shm_name = cfg->shm_name,
+        .acceptors = cfg->acceptors, .admin = cfg->admin,
+        .offline = cfg->trace != NULL};
     if (!net_init(components->net, &np))
         return EXIT_FAILURE;
-    return EXIT_SUCCESS;
+    components->sched->metrics = &components->net->metrics;
+    return open_recordings(cfg, components);
+}
+
+/* A replay runs on the virtual clock instead of polling sockets */
+static bool run_game(net_t *net, scheduler_t *sched)
+{
+    if (net->trace)
+        return trace_run(net->trace, net, &g_stop);
+    run_loop(net, sched);
+    return true;
+}
+
+static void report_drift(const net_t *net)
+{
+    outbuf_t ob = {0};
+
+    if (drift_render(net->metrics.drift, &ob))
+        fwrite(ob.data, 1, ob.len, stderr);
+    outbuf_free(&ob);
 }
 
 static void cleanup_server_components(world_t *world,
     team_t *teams, net_t *net)
 {
+    journal_close(world->journal);
+    trace_close(net->trace);
+    net->trace = NULL;
+    scheduler_destroy(net->sched);
     net_shutdown(net);
     world_destroy(world);
     free(teams);
@@ -124,13 +191,19 @@ static int run_server(const cfg_t *cfg)
         .teams = &teams,
         .net = &net
     };
+    bool ok;
 
+    install_stop_handlers();
+    if (cfg->trace)
+        clock_use_virtual(0);
     if (init_server_components(cfg, &components) != EXIT_SUCCESS)
         return cleanup_world_teams(&world, teams, "Failed to init components");
+    gui_ring_keyframe(&net);
     schedule_periodic_refill(&net, &sched);
-    run_loop(&net, &sched);
+    ok = run_game(&net, &sched);
+    report_drift(&net);
     cleanup_server_components(&world, teams, &net);
-    return EXIT_SUCCESS;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 int main(int ac, char **av)
@@ -0,0 +1,83 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** metrics.c - lock-free server health counters
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "metrics.h"
+#include "clock.h"
+#include "player.h"
+#include <time.h>
+
+uint64_t metrics_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+/* exec_at is in wall-clock milliseconds; lateness is measured to the µs */
+void metrics_fired(metrics_t *m, act_kind_t kind, uint64_t exec_at)
+{
+    uint64_t now = clock_now_us();
+    uint64_t due = exec_at * 1000ULL;
+
+    atomic_fetch_add_explicit(&m->actions[kind], 1, memory_order_relaxed);
+    drift_record(&m->drift[kind], now > due ? now - due : 0);
+}
+
+/* Bucket i holds durations in (2^(i-1), 2^i] microseconds */
+void metrics_loop(metrics_t *m, uint64_t us)
+{
+    int bucket = 0;
+
+    while (bucket < METRICS_LAT_BUCKETS - 1 && us > (1ULL << bucket))
+        ++bucket;
+    atomic_fetch_add_explicit(&m->loop_hist[bucket], 1,
+        memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->loop_sum_us, us, memory_order_relaxed);
+}
+
+/* The game loop is the only writer, so the high-water check cannot race */
+void metrics_sched_len(metrics_t *m, int len)
+{
+    metrics_set(m, M_SCHED_LEN, (uint64_t)len);
+    if ((uint64_t)len > metrics_get(m, M_SCHED_HIGH_WATER))
+        metrics_set(m, M_SCHED_HIGH_WATER, (uint64_t)len);
+}
+
+void metrics_client_open(metrics_t *m, uint32_t id)
+{
+    metrics_client_t *c;
+
+    if (PLAYER_SLOT(id) >= METRICS_CLIENTS)
+        return;
+    c = &m->clients[PLAYER_SLOT(id)];
+    for (int i = 0; i < MIO_COUNT; ++i)
+        atomic_store_explicit(&c->io[i], 0, memory_order_relaxed);
+    atomic_store_explicit(&c->id, id, memory_order_release);
+}
+
+void metrics_client_close(metrics_t *m, uint32_t id)
+{
+    if (PLAYER_SLOT(id) < METRICS_CLIENTS)
+        atomic_store_explicit(&m->clients[PLAYER_SLOT(id)].id, 0,
+            memory_order_release);
+}
+
+void metrics_client_io(metrics_t *m, uint32_t id, metric_io_t dir,
+    const io_count_t *io)
+{
+    metrics_client_t *c;
+
+    if (PLAYER_SLOT(id) >= METRICS_CLIENTS || io->calls == 0)
+        return;
+    c = &m->clients[PLAYER_SLOT(id)];
+    atomic_fetch_add_explicit(&c->io[dir], io->bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->io[dir + 1], io->calls,
+        memory_order_relaxed);
+}
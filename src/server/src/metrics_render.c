@@ -0,0 +1,121 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** metrics_render.c - Prometheus text exposition of the metrics
+*/
+
+#include "metrics.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+typedef struct s_metric_desc {
+    const char *name;
+    const char *type;
+    const char *help;
+} metric_desc_t;
+
+static const metric_desc_t SCALARS[METRIC_COUNT] = {
+    {"zappy_scheduler_queue_length", "gauge", "Actions waiting to fire."},
+    {"zappy_scheduler_queue_high_water", "gauge",
+        "Largest scheduler queue length seen."},
+    {"zappy_scheduler_push_failures_total", "counter",
+        "Actions dropped because the scheduler was full."},
+    {"zappy_commands_rejected_total", "counter",
+        "Commands answered ko without being scheduled."},
+    {"zappy_connections", "gauge", "Connected clients, GUIs included."},
+    {"zappy_gui_connections", "gauge", "Connected GUI clients."},
+    {"zappy_gui_event_bytes_total", "counter",
+        "Bytes of GUI events broadcast."},
+    {"zappy_gui_resyncs_total", "counter",
+        "Snapshots resent to GUIs that fell behind."},
+};
+
+static const metric_desc_t CLIENT_IO[MIO_COUNT] = {
+    {"zappy_client_bytes_in_total", "counter", "Bytes read per client."},
+    {"zappy_client_reads_total", "counter", "read calls per client."},
+    {"zappy_client_bytes_out_total", "counter", "Bytes written per client."},
+    {"zappy_client_writes_total", "counter", "write calls per client."},
+};
+
+static bool put(outbuf_t *ob, const char *fmt, ...)
+{
+    char buf[256];
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= sizeof(buf))
+        return false;
+    return outbuf_append(ob, buf, (size_t)n);
+}
+
+static bool put_header(outbuf_t *ob, const metric_desc_t *d)
+{
+    return put(ob, "# HELP %s %s\n# TYPE %s %s\n",
+        d->name, d->help, d->name, d->type);
+}
+
+static bool render_loop(const metrics_t *m, outbuf_t *ob)
+{
+    static const metric_desc_t d = {"zappy_loop_seconds", "histogram",
+        "Time spent handling one wake-up of the game loop."};
+    uint64_t count = 0;
+    bool ok = put_header(ob, &d);
+
+    for (int i = 0; i < METRICS_LAT_BUCKETS - 1 && ok; ++i) {
+        count += atomic_load_explicit(&m->loop_hist[i], memory_order_relaxed);
+        ok = put(ob, "%s_bucket{le=\"%.6f\"} %llu\n", d.name,
+            (double)(1ULL << i) / 1e6, (unsigned long long)count);
+    }
+    count += atomic_load_explicit(&m->loop_hist[METRICS_LAT_BUCKETS - 1],
+        memory_order_relaxed);
+    return ok && put(ob, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.6f\n"
+        "%s_count %llu\n", d.name, (unsigned long long)count, d.name,
+        (double)atomic_load_explicit(&m->loop_sum_us,
+            memory_order_relaxed) / 1e6, d.name, (unsigned long long)count);
+}
+
+static bool render_actions(const metrics_t *m, outbuf_t *ob)
+{
+    static const metric_desc_t d = {"zappy_actions_fired_total", "counter",
+        "Scheduled actions executed, per command."};
+    bool ok = put_header(ob, &d);
+
+    for (int k = 0; k < ACT_KINDS && ok; ++k)
+        ok = put(ob, "%s{command=\"%s\"} %llu\n", d.name,
+            act_kind_name((act_kind_t)k), (unsigned long long)
+            atomic_load_explicit(&m->actions[k], memory_order_relaxed));
+    return ok;
+}
+
+static bool render_clients(const metrics_t *m, outbuf_t *ob, metric_io_t k)
+{
+    const metrics_client_t *c;
+    uint32_t id;
+    bool ok = put_header(ob, &CLIENT_IO[k]);
+
+    for (int i = 0; i < METRICS_CLIENTS && ok; ++i) {
+        c = &m->clients[i];
+        id = atomic_load_explicit(&c->id, memory_order_acquire);
+        if (id)
+            ok = put(ob, "%s{id=\"%u\"} %llu\n", CLIENT_IO[k].name, id,
+                (unsigned long long)atomic_load_explicit(&c->io[k],
+                    memory_order_relaxed));
+    }
+    return ok;
+}
+
+bool metrics_render(const metrics_t *m, outbuf_t *ob)
+{
+    bool ok = render_loop(m, ob) && render_actions(m, ob);
+
+    for (int i = 0; i < METRIC_COUNT && ok; ++i)
+        ok = put_header(ob, &SCALARS[i]) && put(ob, "%s %llu\n",
+            SCALARS[i].name, (unsigned long long)metrics_get(m, i));
+    for (int k = 0; k < MIO_COUNT && ok; ++k)
+        ok = render_clients(m, ob, (metric_io_t)k);
+    return ok;
+}
@@ -18,20 +18,20 @@
 
 static void trim_cr(player_t *pl)
 {
-    size_t len = strlen(pl->buf);
+    size_t len = strlen(pl->io->buf);
 
-    if (len && pl->buf[len - 1] == '\r') {
+    if (len && pl->io->buf[len - 1] == '\r') {
         --len;
-        pl->buf[len] = '\0';
+        pl->io->buf[len] = '\0';
     }
 }
 
 static void skip_consumed(player_t *pl, char *nl)
 {
-    size_t consumed = (nl - pl->buf) + 1;
+    size_t consumed = (nl - pl->io->buf) + 1;
 
-    memmove(pl->buf, pl->buf + consumed, pl->len - consumed);
-    pl->len -= consumed;
+    memmove(pl->io->buf, pl->io->buf + consumed, pl->io->len - consumed);
+    pl->io->len -= consumed;
 }
 
 static void __attribute__((unused)) send_graphic_welcome(player_t *pl,
@@ -40,7 +40,7 @@ static void __attribute__((unused)) send_graphic_welcome(player_t *pl,
     char line[64];
 
     snprintf(line, sizeof(line), "%d %d\n", world->w, world->h);
-    write(pl->fd, line, strlen(line));
+    player_send(pl, line, strlen(line));
     pl->authed = true;
 }
 
@@ -48,12 +48,13 @@ static void handle_graphic(net_t *net, player_t *pl)
 {
     pl->team_idx = -2;
     pl->authed = true;
-    gui_send_initial(net, pl->fd);
+    metrics_add(&net->metrics, M_GUI_CLIENTS, 1);
+    gui_send_initial(net, pl);
 }
 
 static void handle_team_line(net_t *net, int idx, player_t *pl, char *nl)
 {
-    char *team_name = pl->buf;
+    char *team_name = pl->io->buf;
 
     *nl = '\0';
     trim_cr(pl);
@@ -70,13 +71,13 @@ static void authenticate_player(net_t *net, int idx, const char *buf,
     player_t *pl = (player_t *)net->players[idx];
     char *nl;
 
-    if (pl->len + (size_t)r >= PLAYER_BUF_SZ) {
+    if (pl->io->len + (size_t)r >= PLAYER_BUF_SZ) {
         drop_fd(net, idx);
         return;
     }
-    memcpy(pl->buf + pl->len, buf, (size_t)r);
-    pl->len += (size_t)r;
-    nl = memchr(pl->buf, '\n', pl->len);
+    memcpy(pl->io->buf + pl->io->len, buf, (size_t)r);
+    pl->io->len += (size_t)r;
+    nl = memchr(pl->io->buf, '\n', pl->io->len);
     if (!nl)
         return;
     handle_team_line(net, idx, pl, nl);
@@ -87,11 +88,20 @@ void handle_client(net_t *net, int idx)
     player_t *pl = (player_t *)net->players[idx];
     char buf[256];
     ssize_t r = read(net->pfds[idx].fd, buf, sizeof(buf));
+    io_count_t io = {r > 0 ? (uint64_t)r : 0, 1};
 
+    metrics_client_io(&net->metrics, pl->id, MIO_BYTES_IN, &io);
     if (r <= 0) {
         drop_fd(net, idx);
         return;
     }
+    net_client_input(net, idx, buf, r);
+}
+
+void net_client_input(net_t *net, int idx, const char *buf, ssize_t r)
+{
+    player_t *pl = (player_t *)net->players[idx];
+
     if (!pl->authed) {
         authenticate_player(net, idx, buf, r);
         return;
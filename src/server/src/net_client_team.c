@@ -6,32 +6,29 @@
 */
 
 #include "net_client.h"
+#include "clock.h"
 #include "player.h"
 #include "team.h"
 #include "gui.h"
 #include "egg.h"
+#include "journal.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
-#include <sys/time.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 static void reset_hunger(player_t *pl)
 {
-    struct timeval tv;
-    uint64_t now_ms;
-
-    gettimeofday(&tv, NULL);
-    now_ms = (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-    pl->next_food = now_ms + 126000ULL / (uint64_t)pl->freq;
+    pl->next_food = clock_now_ms() + 126000ULL / (uint64_t)pl->freq;
 }
 
 static void send_ko_and_drop(player_t *pl, net_t *net, int idx)
 {
     const char *ko = "ko\n";
 
-    write(pl->fd, ko, strlen(ko));
+    player_send(pl, ko, strlen(ko));
+    player_flush(pl);
     drop_fd(net, idx);
 }
 
@@ -39,6 +36,7 @@ static void setup_player_auth(player_t *pl, int team_idx)
 {
     pl->team_idx = team_idx;
     pl->authed = true;
+    player_place(pl);
     reset_hunger(pl);
 }
 
@@ -47,10 +45,14 @@ static void send_join_ack(net_t *net, player_t *pl, int remaining)
     char buf[64];
 
     snprintf(buf, sizeof(buf), "%d\n", remaining);
-    write(pl->fd, buf, strlen(buf));
+    player_send(pl, buf, strlen(buf));
+    /* Sent now, one write per line: some clients recv() line by line */
+    player_flush(pl);
     snprintf(buf, sizeof(buf), "%d %d\n", net->world->w, net->world->h);
-    write(pl->fd, buf, strlen(buf));
+    player_send(pl, buf, strlen(buf));
+    player_flush(pl);
     gui_broadcast_pnw(net, pl);
+    journal_player(net->world->journal, J_SPAWN, pl);
     gui_broadcast_pin(net, pl);
 }
 
@@ -64,12 +66,11 @@ static bool handle_egg_hatch(net_t *net, int team_idx, player_t *pl)
 }
 
 static bool handle_team_slot(net_t *net, int idx, player_t *pl,
-    const char *team_name)
+    int team_idx)
 {
     int remaining = 0;
-    int team_idx = team_find(net->teams, net->team_cnt, team_name);
 
-    if (!team_take_slot(net->teams, net->team_cnt, team_name, &remaining)) {
+    if (!team_take_slot(net->teams, team_idx, &remaining)) {
         send_ko_and_drop(pl, net, idx);
         return false;
     }
@@ -80,7 +81,7 @@ static bool handle_team_slot(net_t *net, int idx, player_t *pl,
 
 bool assign_team(net_t *net, int idx, player_t *pl, const char *team_name)
 {
-    int team_idx = team_find(net->teams, net->team_cnt, team_name);
+    int team_idx = team_find(&net->team_index, net->teams, team_name);
 
     if (team_idx < 0) {
         send_ko_and_drop(pl, net, idx);
@@ -88,5 +89,5 @@ bool assign_team(net_t *net, int idx, player_t *pl, const char *team_name)
     }
     if (handle_egg_hatch(net, team_idx, pl))
         return true;
-    return handle_team_slot(net, idx, pl, team_name);
+    return handle_team_slot(net, idx, pl, team_idx);
 }
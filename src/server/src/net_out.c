@@ -0,0 +1,129 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** net_out - per-connection outbound queues
+*/
+
+#include "net_out.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+static void compact(outbuf_t *ob)
+{
+    if (!ob->off)
+        return;
+    memmove(ob->data, ob->data + ob->off, ob->len - ob->off);
+    ob->len -= ob->off;
+    ob->off = 0;
+}
+
+bool outbuf_reserve(outbuf_t *ob, size_t n)
+{
+    size_t cap = ob->cap ? ob->cap : OUTBUF_MIN_CAP;
+    char *data;
+
+    if (ob->len + n <= ob->cap)
+        return true;
+    compact(ob);
+    if (ob->len + n <= ob->cap)
+        return true;
+    while (cap < ob->len + n)
+        cap *= 2;
+    data = realloc(ob->data, cap);
+    if (!data)
+        return false;
+    ob->data = data;
+    ob->cap = cap;
+    return true;
+}
+
+bool outbuf_init(outbuf_t *ob, size_t cap)
+{
+    ob->data = malloc(cap);
+    ob->off = 0;
+    ob->len = 0;
+    ob->cap = ob->data ? cap : 0;
+    return ob->data != NULL;
+}
+
+bool outbuf_append(outbuf_t *ob, const char *msg, size_t n)
+{
+    if (!n)
+        return true;
+    if (!outbuf_reserve(ob, n))
+        return false;
+    memcpy(ob->data + ob->len, msg, n);
+    ob->len += n;
+    return true;
+}
+
+bool outbuf_append_uint(outbuf_t *ob, unsigned long long v)
+{
+    char digits[20];
+    size_t n = 0;
+
+    do {
+        digits[sizeof(digits) - 1 - n] = (char)('0' + v % 10);
+        v /= 10;
+        n++;
+    } while (v);
+    return outbuf_append(ob, digits + sizeof(digits) - n, n);
+}
+
+bool outbuf_flush(outbuf_t *ob, int fd, io_count_t *io)
+{
+    io_count_t local = {0};
+    ssize_t w;
+
+    if (!io)
+        io = &local;
+    while (ob->off < ob->len) {
+        w = write(fd, ob->data + ob->off, ob->len - ob->off);
+        io->calls++;
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        ob->off += (size_t)w;
+        io->bytes += (uint64_t)w;
+        if (w > 0)
+            ob->mid_line = ob->data[ob->off - 1] != '\n';
+    }
+    ob->off = 0;
+    ob->len = 0;
+    return true;
+}
+
+void outbuf_drop_pending(outbuf_t *ob)
+{
+    char *nl;
+
+    if (!ob->mid_line) {
+        ob->off = 0;
+        ob->len = 0;
+        return;
+    }
+    nl = memchr(ob->data + ob->off, '\n', ob->len - ob->off);
+    if (nl)
+        ob->len = (size_t)(nl - ob->data) + 1;
+}
+
+void outbuf_recycle(outbuf_t *ob, size_t keep)
+{
+    if (ob->cap > keep) {
+        outbuf_free(ob);
+        return;
+    }
+    ob->off = 0;
+    ob->len = 0;
+    ob->mid_line = false;
+}
+
+void outbuf_free(outbuf_t *ob)
+{
+    free(ob->data);
+    memset(ob, 0, sizeof(*ob));
+}
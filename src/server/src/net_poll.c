@@ -5,10 +5,14 @@
 ** net_poll
 */
 
+#define _GNU_SOURCE
 #include "net_poll.h"
+#include "clock.h"
 #include "player.h"
 #include "net_client.h"
 #include "gui.h"
+#include "gui_ring.h"
+#include "acceptor.h"
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <stdio.h>
@@ -16,18 +20,10 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
-#include <sys/time.h>
 #include <stdint.h>
 #include <limits.h>
 #include "net_utils.h"
-
-static uint64_t now_ms(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
+#include "journal.h"
 
 static int compute_poll_timeout(const net_t *net, int default_ms)
 {
@@ -36,7 +32,7 @@ static int compute_poll_timeout(const net_t *net, int default_ms)
     uint64_t until;
 
     if (net && net->sched) {
-        now = now_ms();
+        now = clock_now_ms();
         until = scheduler_time_until_next(net->sched, now);
         if (until != UINT64_MAX && until < (uint64_t)wait_ms)
             wait_ms = (int)until;
@@ -54,15 +50,60 @@ void drop_fd(net_t *net, int idx)
 
     if (pl && pl->authed && pl->team_idx >= 0) {
         gui_broadcast_pdi(net, pl);
+        journal_event(net->world->journal, J_LEAVE, (uint64_t[]){pl->id}, 1);
         team_release_slot(net->teams, pl->team_idx);
     }
-    if (pl && net->sched) {
-        scheduler_remove_player_actions(net->sched, pl);
+    if (IS_GUI(pl))
+        metrics_add(&net->metrics, M_GUI_CLIENTS, (uint64_t)-1);
+    if (pl) {
+        metrics_client_close(&net->metrics, pl->id);
+        ritual_leave(pl);
     }
-    player_destroy(pl);
+    if (pl && net->sched)
+        scheduler_remove_player_actions(net->sched, pl);
+    player_destroy(&net->pool, pl);
     --net->nfds;
     net->players[idx] = net->players[net->nfds];
     net->pfds[idx] = net->pfds[net->nfds];
+    metrics_set(&net->metrics, M_CLIENTS,
+        (uint64_t)(net->nfds - net->nlisten));
+}
+
+static bool add_listener(net_t *net, int fd)
+{
+    if (fd < 0)
+        return false;
+    net->pfds[net->nlisten].fd = fd;
+    net->pfds[net->nlisten].events = POLLIN;
+    ++net->nlisten;
+    net->nfds = net->nlisten;
+    return true;
+}
+
+/* A keyframe slot fits a full snapshot with room for every player */
+static size_t shm_keyframe_size(const world_t *w)
+{
+    return (size_t)w->w * (size_t)w->h * GUI_TILE_BYTES + GUI_OUTQ_MAX;
+}
+
+/* With -r, N threads own SO_REUSEPORT listeners and feed a hand-off pipe */
+static bool setup_listeners(net_t *net, const net_params_t *p)
+{
+    if (p->acceptors > 0) {
+        if (!acceptor_pool_start(&net->acceptors, p->port, p->acceptors))
+            return false;
+        add_listener(net, net->acceptors.pipe[0]);
+    } else {
+        if (!setup_listen_socket(net, p->port))
+            return false;
+        add_listener(net, net->listen_fd);
+    }
+    if (p->unix_path) {
+        net->unix_path = p->unix_path;
+        if (!add_listener(net, setup_unix_listen_socket(p->unix_path)))
+            return false;
+    }
+    return true;
 }
 
 bool net_init(net_t *net, const net_params_t *p)
@@ -73,71 +114,175 @@ bool net_init(net_t *net, const net_params_t *p)
     net->world = p->world;
     net->teams = p->teams;
     net->team_cnt = p->team_cnt;
-    net->egg_count = 0;
-    net->next_egg_id = 1;
-    if (!setup_listen_socket(net, p->port))
+    ritual_pool_init(&net->rituals);
+    if (!team_table_build(&net->team_index, p->teams, p->team_cnt) ||
+        !egg_pool_init(&net->eggs, p->team_cnt, net->world) ||
+        !player_pool_init(&net->pool, NET_MAX_FDS) ||
+        !arena_init(&net->tick, NET_TICK_ARENA) ||
+        (!p->offline && !setup_listeners(net, p)))
         return false;
-    net->pfds[0].fd = net->listen_fd;
-    net->pfds[0].events = POLLIN;
-    net->nfds = 1;
-    return true;
+    if (p->shm_name) {
+        net->ring = gui_ring_open(p->shm_name, shm_keyframe_size(net->world));
+        if (!net->ring)
+            return false;
+    }
+    return !p->admin || admin_start(&net->admin, p->admin, &net->metrics);
 }
 
-static void send_welcome(int fd)
+/* WELCOME is only queued: the accept batch flushes all greetings at once */
+player_t *net_add_client(net_t *net, int fd)
 {
-    const char *msg = "WELCOME\n";
-
-    write(fd, msg, strlen(msg));
-}
+    player_t *pl = NULL;
 
-static void add_client(net_t *net, int fd)
-{
-    if (net->nfds >= NET_MAX_FDS) {
-        close(fd);
-        return;
+    if (net->nfds < NET_MAX_FDS)
+        pl = player_create(&net->pool, fd, net);
+    if (!pl) {
+        if (fd >= 0)
+            close(fd);
+        return NULL;
     }
-    set_nonblock(fd);
     net->pfds[net->nfds].fd = fd;
     net->pfds[net->nfds].events = POLLIN;
-    net->players[net->nfds] = player_create(fd, net->world, net->freq, net);
-    if (!net->players[net->nfds]) {
-        close(fd);
-        return;
-    }
+    net->pfds[net->nfds].revents = 0;
+    net->players[net->nfds] = pl;
     ++net->nfds;
-    send_welcome(fd);
+    metrics_client_open(&net->metrics, pl->id);
+    metrics_set(&net->metrics, M_CLIENTS,
+        (uint64_t)(net->nfds - net->nlisten));
+    if (!outbuf_append(&pl->out, "WELCOME\n", 8))
+        pl->doomed = true;
+    return pl;
 }
 
-static void accept_new(net_t *net)
+static void flush_from(net_t *net, int first)
 {
+    for (int i = first; i < net->nfds; ++i)
+        player_flush((player_t *)net->players[i]);
+}
+
+static void accept_new(net_t *net, int listen_fd)
+{
+    int first = net->nfds;
     int fd;
 
     while (1) {
-        fd = accept(net->listen_fd, NULL, NULL);
+        fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
         if (fd < 0)
-            return;
-        add_client(net, fd);
+            break;
+        net_add_client(net, fd);
+    }
+    flush_from(net, first);
+}
+
+static bool is_handoff(const net_t *net, int fd)
+{
+    return net->acceptors.count > 0 && fd == net->acceptors.pipe[0];
+}
+
+static void take_handoffs(net_t *net)
+{
+    int fds[64];
+    int n;
+
+    while ((n = acceptor_pool_take(&net->acceptors, fds, 64)) > 0)
+        for (int i = 0; i < n; ++i)
+            net_add_client(net, fds[i]);
+}
+
+static void accept_ready(net_t *net)
+{
+    for (int i = 0; i < net->nlisten; ++i) {
+        if (!(net->pfds[i].revents & POLLIN))
+            continue;
+        if (is_handoff(net, net->pfds[i].fd))
+            take_handoffs(net);
+        else
+            accept_new(net, net->pfds[i].fd);
+    }
+}
+
+static void arm_pollout(net_t *net)
+{
+    player_t *pl;
+
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        pl = (player_t *)net->players[i];
+        net->pfds[i].events = POLLIN;
+        if (pl && outbuf_pending(&pl->out))
+            net->pfds[i].events |= POLLOUT;
+    }
+}
+
+static void flush_client(net_t *net, int idx)
+{
+    player_t *pl = (player_t *)net->players[idx];
+
+    if (!pl)
+        return;
+    player_flush(pl);
+    if (!outbuf_pending(&pl->out))
+        pl->resync_pending = false;
+}
+
+void net_flush_all(net_t *net)
+{
+    player_t *pl;
+
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        pl = (player_t *)net->players[i];
+        if (pl && !pl->doomed && outbuf_pending(&pl->out))
+            flush_client(net, i);
+    }
+}
+
+/* Walk backwards: drop_fd moves the last slot into the dropped one */
+void net_drop_doomed(net_t *net)
+{
+    player_t *pl;
+
+    for (int i = net->nfds - 1; i >= net->nlisten; --i) {
+        pl = (player_t *)net->players[i];
+        if (pl && pl->doomed)
+            drop_fd(net, i);
     }
 }
 
 void net_poll_once(net_t *net, int timeout_ms)
 {
     int wait_ms = compute_poll_timeout(net, timeout_ms);
+    int ready;
 
-    if (poll(net->pfds, net->nfds, wait_ms) <= 0)
+    net_drop_doomed(net);
+    arm_pollout(net);
+    ready = poll(net->pfds, net->nfds, wait_ms);
+    net->woke_us = metrics_now_us();
+    if (ready <= 0)
         return;
-    if (net->pfds[0].revents & POLLIN)
-        accept_new(net);
-    for (int i = 1; i < net->nfds; ++i) {
+    accept_ready(net);
+    for (int i = net->nlisten; i < net->nfds; ++i) {
+        if (net->pfds[i].revents & POLLOUT)
+            flush_client(net, i);
         if (net->pfds[i].revents & POLLIN)
             handle_client(net, i);
     }
+    net_drop_doomed(net);
 }
 
 void net_shutdown(net_t *net)
 {
-    while (net->nfds > 0)
-        drop_fd(net, 0);
-    close(net->listen_fd);
+    admin_stop(&net->admin);
+    while (net->nfds > net->nlisten)
+        drop_fd(net, net->nlisten);
+    for (int i = 0; i < net->nlisten; ++i)
+        if (!is_handoff(net, net->pfds[i].fd))
+            close(net->pfds[i].fd);
+    acceptor_pool_stop(&net->acceptors);
+    if (net->unix_path)
+        unlink(net->unix_path);
+    gui_ring_close(net->ring);
+    player_pool_destroy(&net->pool);
+    egg_pool_destroy(&net->eggs);
+    team_table_destroy(&net->team_index);
+    arena_destroy(&net->tick);
     memset(net, 0, sizeof(*net));
 }
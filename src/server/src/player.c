@@ -6,70 +6,147 @@
 */
 
 #include "player.h"
+#include "clock.h"
+#include "net_poll.h"
 #include "scheduler.h"
 #include "world.h"
+#include "trace.h"
+#include "gui.h"
+#include "gui_query.h"
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
-#include <sys/time.h>
 #include <stdint.h>
 
-static uint64_t now_ms(void)
-{
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000ULL + tv.tv_usec / 1000ULL;
-}
-
 static void player_setup(player_t *p, int fd, struct s_world *world, int freq)
 {
     p->fd = fd;
     p->world = world;
     if (world) {
-        p->x = rand() % world->w;
-        p->y = rand() % world->h;
+        p->x = (int)rng_below(&world->rng[RNG_SPAWN], (uint32_t)world->w);
+        p->y = (int)rng_below(&world->rng[RNG_SPAWN], (uint32_t)world->h);
+        p->dir = (int)rng_below(&world->rng[RNG_SPAWN], 4);
     }
-    p->dir = rand() % 4;
     p->level = 1;
     p->authed = false;
     p->team_idx = -1;
     memset(p->inv, 0, sizeof(p->inv));
     p->inv[RES_FOOD] = 10;
     p->freq = freq;
-    p->next_food = now_ms() + 126000ULL / (uint64_t)freq;
+    p->next_food = clock_now_ms() + 126000ULL / (uint64_t)freq;
 }
 
-player_t *player_create(int fd, struct s_world *world,
-    int freq, struct s_net *net)
+/* Reset everything but the output queue and input state, whose storage is
+   reused, and bump the slot's generation so the previous ID goes stale */
+static void player_clear(player_t *p, uint32_t slot)
 {
-    player_t *p = calloc(1, sizeof(*p));
+    outbuf_t out = p->out;
+    player_io_t *io = p->io;
+    uint32_t gen = ((p->id >> PLAYER_SLOT_BITS) + 1) & PLAYER_GEN_MASK;
 
-    if (!p)
+    memset(p, 0, sizeof(*p));
+    p->out = out;
+    outbuf_recycle(&p->out, PLAYER_OUT_KEEP);
+    p->io = io;
+    p->io->len = 0;
+    p->id = PLAYER_ID(gen ? gen : 1, slot);
+}
+
+player_t *player_create(player_pool_t *pool, int fd, struct s_net *net)
+{
+    player_t *p;
+
+    if (pool->free_cnt == 0)
         return NULL;
-    player_setup(p, fd, world, freq);
+    p = pool->free[--pool->free_cnt];
+    player_clear(p, (uint32_t)(p - pool->slab));
+    player_setup(p, fd, net->world, net->freq);
     p->net = net;
     return p;
 }
 
-void player_destroy(player_t *p)
+static bool player_on_map(const player_t *p)
+{
+    return p->authed && p->team_idx >= 0 && p->world;
+}
+
+static void player_leave(player_t *p)
+{
+    tile_t *t = world_get_tile(p->world, p->x, p->y);
+
+    if (!t || t->players == 0)
+        return;
+    t->players--;
+    tile_touch(t);
+}
+
+void player_place(player_t *p)
+{
+    tile_t *t = world_get_tile(p->world, p->x, p->y);
+
+    if (!t || t->players == UINT16_MAX)
+        return;
+    t->players++;
+    tile_touch(t);
+}
+
+void player_move(player_t *p, int x, int y)
+{
+    player_leave(p);
+    p->x = x;
+    p->y = y;
+    player_place(p);
+}
+
+void player_destroy(player_pool_t *pool, player_t *p)
 {
     if (!p)
         return;
+    if (player_on_map(p))
+        player_leave(p);
     for (int i = 0; i < p->q_len; ++i)
-        free(p->queue[i]);
+        free(p->io->queue[i]);
+    p->q_len = 0;
+    outbuf_recycle(&p->out, PLAYER_OUT_KEEP);
     close(p->fd);
-    free(p);
+    p->fd = -1;
+    p->net = NULL;
+    pool->free[pool->free_cnt++] = p;
+}
+
+/* A closed slot keeps its queue storage for the next connection, which
+   must not inherit a late reply meant for the previous one */
+void player_send(player_t *p, const char *msg, size_t n)
+{
+    if (!p->net)
+        return;
+    if (!outbuf_append(&p->out, msg, n))
+        p->doomed = true;
+}
+
+void player_flush(player_t *p)
+{
+    io_count_t io = {0};
+
+    if (p->net && p->net->trace) {
+        trace_capture(p->net->trace, p);
+        return;
+    }
+    if (!outbuf_flush(&p->out, p->fd, &io))
+        p->doomed = true;
+    if (p->net)
+        metrics_client_io(&p->net->metrics, p->id, MIO_BYTES_OUT, &io);
 }
 
 static void enqueue_cmd(player_t *p, const char *line,
     scheduler_t *sched)
 {
-    const char *ko;
-
+    if (IS_GUI(p) && p->net) {
+        gui_command(p->net, p, line);
+        return;
+    }
     if (p->q_len >= PLAYER_QUEUE_MAX) {
-        ko = "ko\n";
-        write(p->fd, ko, strlen(ko));
+        player_send(p, "ko\n", 3);
         return;
     }
     sched_cmd_from_string(p, line, sched, p->freq);
@@ -78,9 +155,9 @@ static void enqueue_cmd(player_t *p, const char *line,
 static void handle_line(player_t *p, size_t start, size_t end,
     scheduler_t *sched)
 {
-    if (end > start && p->buf[end - 1] == '\r')
-        p->buf[end - 1] = '\0';
-    enqueue_cmd(p, p->buf + start, sched);
+    if (end > start && p->io->buf[end - 1] == '\r')
+        p->io->buf[end - 1] = '\0';
+    enqueue_cmd(p, p->io->buf + start, sched);
 }
 
 bool player_feed(player_t *p, const char *data, size_t n,
@@ -89,21 +166,21 @@ bool player_feed(player_t *p, const char *data, size_t n,
     size_t start;
     size_t i;
 
-    if (p->len + n >= PLAYER_BUF_SZ)
+    if (p->io->len + n >= PLAYER_BUF_SZ)
         return false;
-    memcpy(p->buf + p->len, data, n);
-    p->len += n;
+    memcpy(p->io->buf + p->io->len, data, n);
+    p->io->len += n;
     start = 0;
-    for (i = 0; i < p->len; ++i) {
-        if (p->buf[i] == '\n') {
-            p->buf[i] = '\0';
+    for (i = 0; i < p->io->len; ++i) {
+        if (p->io->buf[i] == '\n') {
+            p->io->buf[i] = '\0';
             handle_line(p, start, i, sched);
             start = i + 1;
         }
     }
     if (start) {
-        memmove(p->buf, p->buf + start, p->len - start);
-        p->len -= start;
+        memmove(p->io->buf, p->io->buf + start, p->io->len - start);
+        p->io->len -= start;
     }
     return true;
 }
@@ -0,0 +1,56 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** player_pool.c - preallocated player slab reused across connections
+*/
+
+#include "player.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool player_pool_init(player_pool_t *pool, int cap)
+{
+    memset(pool, 0, sizeof(*pool));
+    if (cap <= 0 || cap > (1 << PLAYER_SLOT_BITS))
+        return false;
+    pool->slab = calloc((size_t)cap, sizeof(*pool->slab));
+    pool->io = calloc((size_t)cap, sizeof(*pool->io));
+    pool->free = calloc((size_t)cap, sizeof(*pool->free));
+    if (!pool->slab || !pool->io || !pool->free)
+        return false;
+    pool->cap = cap;
+    for (int i = cap - 1; i >= 0; --i) {
+        pool->slab[i].fd = -1;
+        pool->slab[i].io = &pool->io[i];
+        if (!outbuf_init(&pool->slab[i].out, OUTBUF_MIN_CAP))
+            return false;
+        pool->free[pool->free_cnt++] = &pool->slab[i];
+    }
+    return true;
+}
+
+void player_pool_destroy(player_pool_t *pool)
+{
+    if (pool->slab)
+        for (int i = 0; i < pool->cap; ++i)
+            outbuf_free(&pool->slab[i].out);
+    free(pool->slab);
+    free(pool->io);
+    free(pool->free);
+    memset(pool, 0, sizeof(*pool));
+}
+
+player_t *player_alive(player_t *p, uint32_t id)
+{
+    return (p && p->id == id && p->net) ? p : NULL;
+}
+
+player_t *player_by_id(player_pool_t *pool, uint32_t id)
+{
+    uint32_t slot = PLAYER_SLOT(id);
+
+    if (slot >= (uint32_t)pool->cap)
+        return NULL;
+    return player_alive(&pool->slab[slot], id);
+}
@@ -0,0 +1,93 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** ritual - registry of the incantations in progress
+*/
+
+#include "ritual.h"
+#include "net_poll.h"
+
+_Static_assert(RITUAL_MAX >= NET_MAX_FDS,
+    "every player must be able to start a ritual");
+
+void ritual_pool_init(ritual_pool_t *pool)
+{
+    pool->free_cnt = 0;
+    for (int i = RITUAL_MAX - 1; i >= 0; --i)
+        pool->free[pool->free_cnt++] = &pool->slots[i];
+}
+
+ritual_t *ritual_open(ritual_pool_t *pool, const player_t *init)
+{
+    ritual_t *r;
+
+    if (pool->free_cnt == 0)
+        return NULL;
+    r = pool->free[--pool->free_cnt];
+    *r = (ritual_t){ .net = init->net, .x = init->x, .y = init->y,
+        .level = init->level, .initiator = init->id };
+    return r;
+}
+
+void ritual_join(ritual_t *r, player_t *p)
+{
+    p->ritual = r;
+    p->ritual_next = r->first;
+    r->first = p;
+    r->count += 1;
+}
+
+void ritual_leave(player_t *p)
+{
+    ritual_t *r = p->ritual;
+    player_t **link;
+
+    if (!r)
+        return;
+    link = &r->first;
+    while (*link && *link != p)
+        link = &(*link)->ritual_next;
+    if (*link) {
+        *link = p->ritual_next;
+        r->count -= 1;
+    }
+    p->ritual = NULL;
+    p->ritual_next = NULL;
+}
+
+void ritual_close(ritual_pool_t *pool, ritual_t *r)
+{
+    player_t *next;
+
+    for (player_t *p = r->first; p; p = next) {
+        next = p->ritual_next;
+        p->ritual = NULL;
+        p->ritual_next = NULL;
+    }
+    r->first = NULL;
+    r->count = 0;
+    pool->free[pool->free_cnt++] = r;
+}
+
+player_t *ritual_member(const ritual_t *r, uint32_t id)
+{
+    for (player_t *p = r->first; p; p = p->ritual_next)
+        if (p->id == id)
+            return p;
+    return NULL;
+}
+
+bool ritual_in_place(const ritual_t *r, const player_t *p)
+{
+    return p->x == r->x && p->y == r->y && p->level == r->level;
+}
+
+int ritual_in_place_count(const ritual_t *r)
+{
+    int cnt = 0;
+
+    for (const player_t *p = r->first; p; p = p->ritual_next)
+        cnt += ritual_in_place(r, p);
+    return cnt;
+}
@@ -0,0 +1,67 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** rng.c - xoshiro256** with splitmix64 seeding
+*/
+
+#include "rng.h"
+
+static uint64_t splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(rng_t *r, uint64_t seed, rng_stream_t stream)
+{
+    uint64_t x = seed ^ ((uint64_t)stream * 0xd1b54a32d192ed03ULL);
+
+    for (int i = 0; i < 4; ++i)
+        r->s[i] = splitmix64(&x);
+}
+
+uint64_t rng_next(rng_t *r)
+{
+    uint64_t *s = r->s;
+    uint64_t out = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return out;
+}
+
+uint32_t rng_below(rng_t *r, uint32_t n)
+{
+    uint64_t m = (rng_next(r) >> 32) * (uint64_t)n;
+    uint32_t low = (uint32_t)m;
+    uint32_t threshold;
+
+    if (low < n) {
+        threshold = (uint32_t)-n % n;
+        while (low < threshold) {
+            m = (rng_next(r) >> 32) * (uint64_t)n;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+void rng_fill_below(rng_t *r, uint32_t n, uint32_t *out, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        out[i] = rng_below(r, n);
+}
@@ -8,13 +8,35 @@
 #include "scheduler.h"
 #include "player.h"
 #include "world.h"
+#include "metrics.h"
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
 
+static const char *const ACT_NAMES[ACT_KINDS] = {
+    "internal", "Forward", "Right", "Left", "Look", "Inventory",
+    "Broadcast", "Connect_nbr", "Fork", "Eject", "Take", "Set",
+    "Incantation",
+};
+
+const char *act_kind_name(act_kind_t kind)
+{
+    return kind < ACT_KINDS ? ACT_NAMES[kind] : ACT_NAMES[ACT_INTERNAL];
+}
+
 void scheduler_init(scheduler_t *s)
 {
     s->len = 0;
+    s->metrics = NULL;
+    slab_init(&s->ctx, SCHED_CTX_SZ, 64);
+    slab_init(&s->text, SCHED_TEXT_SZ, 16);
+}
+
+void scheduler_destroy(scheduler_t *s)
+{
+    s->len = 0;
+    slab_destroy(&s->ctx);
+    slab_destroy(&s->text);
 }
 
 static void swap(action_t *a, action_t *b)
@@ -29,8 +51,11 @@ bool scheduler_push(scheduler_t *s, action_t act)
 {
     int i;
 
-    if (s->len >= SCHED_MAX)
+    if (s->len >= SCHED_MAX) {
+        if (s->metrics)
+            metrics_add(s->metrics, M_SCHED_PUSH_FAILED, 1);
         return false;
+    }
     i = s->len;
     s->len += 1;
     s->items[i] = act;
@@ -38,6 +63,8 @@ bool scheduler_push(scheduler_t *s, action_t act)
         swap(&s->items[i], &s->items[(i - 1) / 2]);
         i = (i - 1) / 2;
     }
+    if (s->metrics)
+        metrics_sched_len(s->metrics, s->len);
     return true;
 }
 
@@ -79,8 +106,12 @@ void scheduler_run_ready(scheduler_t *s, uint64_t now)
     while (s->len && s->items[0].exec_at <= now) {
         act = s->items[0];
         heap_pop(s);
+        if (s->metrics)
+            metrics_fired(s->metrics, act.kind, act.exec_at);
         act.fn(act.pl);
     }
+    if (s->metrics)
+        metrics_sched_len(s->metrics, s->len);
 }
 
 static void copy_item_if_needed(scheduler_t *s,
@@ -105,11 +136,25 @@ void scheduler_remove_player_actions(scheduler_t *s, struct s_player *pl)
         copy_item_if_needed(s, i, &write_pos, pl);
     }
     s->len = write_pos;
+    if (s->metrics)
+        metrics_sched_len(s->metrics, s->len);
     for (int i = s->len / 2 - 1; i >= 0; --i) {
         bubble_down(s, i);
     }
 }
 
+void scheduler_rescale(scheduler_t *s, uint64_t now, uint64_t num,
+    uint64_t den)
+{
+    action_t *act;
+
+    for (int i = 0; i < s->len; ++i) {
+        act = &s->items[i];
+        if (act->exec_at > now)
+            act->exec_at = now + (act->exec_at - now) * num / den;
+    }
+}
+
 uint64_t scheduler_time_until_next(const scheduler_t *s, uint64_t now)
 {
     if (!s || s->len == 0)
@@ -0,0 +1,73 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** slab - fixed-size blocks for objects that outlive a tick
+*/
+
+#include "arena.h"
+#include <stdlib.h>
+
+void slab_init(slab_t *s, size_t size, int per_chunk)
+{
+    size_t body = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+    *s = (slab_t){0};
+    s->stride = sizeof(slab_hdr_t) + body;
+    s->per_chunk = per_chunk > 0 ? per_chunk : 1;
+}
+
+static bool slab_grow(slab_t *s)
+{
+    slab_chunk_t *c = malloc(sizeof(*c) + s->stride * (size_t)s->per_chunk);
+    slab_hdr_t *h;
+
+    if (!c)
+        return false;
+    c->next = s->chunks;
+    s->chunks = c;
+    for (int i = s->per_chunk - 1; i >= 0; --i) {
+        h = (slab_hdr_t *)((char *)c->blocks + s->stride * (size_t)i);
+        h->next = s->free;
+        s->free = h;
+    }
+    return true;
+}
+
+void *slab_alloc(slab_t *s)
+{
+    slab_hdr_t *h;
+
+    if (!s->free && !slab_grow(s))
+        return NULL;
+    h = s->free;
+    s->free = h->next;
+    h->owner = s;
+    s->live += 1;
+    return h + 1;
+}
+
+void slab_free(void *obj)
+{
+    slab_hdr_t *h;
+    slab_t *s;
+
+    if (!obj)
+        return;
+    h = (slab_hdr_t *)obj - 1;
+    s = h->owner;
+    h->next = s->free;
+    s->free = h;
+    s->live -= 1;
+}
+
+void slab_destroy(slab_t *s)
+{
+    slab_chunk_t *next;
+
+    for (slab_chunk_t *c = s->chunks; c; c = next) {
+        next = c->next;
+        free(c);
+    }
+    *s = (slab_t){0};
+}
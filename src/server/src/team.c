@@ -6,28 +6,92 @@
 */
 
 #include "team.h"
+#include <stdlib.h>
 #include <string.h>
 
 void teams_init(team_t *arr, int count, char **names, int slots)
 {
     for (int i = 0; i < count; ++i) {
         arr[i].name = names[i];
+        arr[i].name_len = strlen(names[i]);
         arr[i].slots = slots;
     }
 }
 
-int team_find(team_t *arr, int count, const char *name)
+/* FNV-1a, the seed perturbs the offset basis */
+static uint32_t name_hash(const char *name, size_t len, uint32_t seed)
 {
-    for (int i = 0; i < count; ++i)
-        if (!strcmp(arr[i].name, name))
-            return i;
-    return -1;
+    uint32_t h = 2166136261U ^ seed;
+
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619U;
+    }
+    return h;
+}
+
+static bool same_name(const team_t *t, const char *name, size_t len)
+{
+    return t->name_len == len && !memcmp(t->name, name, len);
+}
+
+/* Fills the table with the current seed; false on a real collision */
+static bool try_seed(team_table_t *table, const team_t *arr, int count)
+{
+    uint32_t b;
+    int *slot;
+
+    memset(table->slots, -1, (table->mask + 1) * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        b = name_hash(arr[i].name, arr[i].name_len, table->seed) & table->mask;
+        slot = &table->slots[b];
+        if (*slot >= 0 && same_name(&arr[*slot], arr[i].name, arr[i].name_len))
+            continue;
+        if (*slot >= 0)
+            return false;
+        *slot = i;
+    }
+    return true;
 }
 
-bool team_take_slot(team_t *arr, int count, const char *name, int *remaining)
+bool team_table_build(team_table_t *table, const team_t *arr, int count)
 {
-    int idx = team_find(arr, count, name);
+    uint32_t size = 1;
 
+    while (size < 2U * (uint32_t)count)
+        size <<= 1;
+    table->slots = NULL;
+    while (1) {
+        free(table->slots);
+        table->slots = malloc(size * sizeof(int));
+        if (!table->slots)
+            return false;
+        table->mask = size - 1;
+        for (table->seed = 0; table->seed < 64; ++table->seed)
+            if (try_seed(table, arr, count))
+                return true;
+        size <<= 1;
+    }
+}
+
+void team_table_destroy(team_table_t *table)
+{
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+int team_find(const team_table_t *table, const team_t *arr, const char *name)
+{
+    size_t len = strlen(name);
+    int idx = table->slots[name_hash(name, len, table->seed) & table->mask];
+
+    if (idx < 0 || !same_name(&arr[idx], name, len))
+        return -1;
+    return idx;
+}
+
+bool team_take_slot(team_t *arr, int idx, int *remaining)
+{
     if (idx < 0)
         return false;
     if (arr[idx].slots <= 0)
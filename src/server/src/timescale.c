@@ -0,0 +1,39 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** timescale - live change of the time unit
+*/
+
+#include "timescale.h"
+#include "clock.h"
+#include "player.h"
+#include "world.h"
+#include "journal.h"
+
+static void rescale_player(player_t *pl, uint64_t now, int from, int to)
+{
+    pl->freq = to;
+    if (!pl->authed || pl->team_idx < 0 || pl->next_food <= now)
+        return;
+    pl->next_food = now + (pl->next_food - now) * (uint64_t)from /
+        (uint64_t)to;
+}
+
+bool timescale_set(net_t *net, int freq)
+{
+    uint64_t now = clock_now_ms();
+    int from = net->freq;
+
+    if (freq <= 0 || freq > TIMESCALE_MAX_FREQ)
+        return false;
+    if (freq == from)
+        return true;
+    scheduler_rescale(net->sched, now, (uint64_t)from, (uint64_t)freq);
+    for (int i = net->nlisten; i < net->nfds; ++i)
+        if (net->players[i])
+            rescale_player(net->players[i], now, from, freq);
+    net->freq = freq;
+    journal_event(net->world->journal, J_FREQ, (uint64_t[]){(uint64_t)freq}, 1);
+    return true;
+}
@@ -0,0 +1,116 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** trace - reading the recorded client input
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char SEND_OP[] = "send";
+
+static bool parse_op(const char *p, trace_event_t *ev)
+{
+    size_t send_len = sizeof(SEND_OP) - 1;
+
+    ev->text = "";
+    ev->len = 0;
+    if (!strcmp(p, "connect"))
+        ev->op = TRACE_CONNECT;
+    else if (!strcmp(p, "close"))
+        ev->op = TRACE_CLOSE;
+    else if (!strncmp(p, SEND_OP, send_len) &&
+        (p[send_len] == ' ' || !p[send_len])) {
+        ev->op = TRACE_SEND;
+        ev->text = p[send_len] ? p + send_len + 1 : p + send_len;
+        ev->len = strlen(ev->text);
+    } else
+        return false;
+    return true;
+}
+
+static bool parse_event(const char *line, trace_event_t *ev)
+{
+    char *end = NULL;
+    long client;
+
+    if (*line < '0' || *line > '9')
+        return false;
+    ev->at = strtoull(line, &end, 10);
+    if (*end != ' ')
+        return false;
+    line = end + 1;
+    client = strtol(line, &end, 10);
+    if (end == line || *end != ' ' || client < 0 ||
+        client >= TRACE_MAX_CLIENTS)
+        return false;
+    ev->client = (int)client;
+    return parse_op(end + 1, ev);
+}
+
+/* Blank lines and lines starting with # are comments */
+static bool next_line(trace_t *t)
+{
+    ssize_t n;
+
+    do {
+        n = getline(&t->line, &t->cap, t->in);
+        if (n < 0)
+            return false;
+        t->lineno++;
+        while (n > 0 && (t->line[n - 1] == '\n' || t->line[n - 1] == '\r'))
+            t->line[--n] = '\0';
+    } while (n == 0 || t->line[0] == '#');
+    return true;
+}
+
+void trace_read_next(trace_t *t)
+{
+    uint64_t last = t->next.at;
+
+    t->pending = false;
+    if (t->failed || !next_line(t))
+        return;
+    if (!parse_event(t->line, &t->next) || t->next.at < last) {
+        fprintf(stderr, "trace:%zu: malformed or out of order event\n",
+            t->lineno);
+        t->failed = true;
+        return;
+    }
+    t->pending = true;
+}
+
+trace_t *trace_open(const char *path, const char *out_path)
+{
+    trace_t *t = calloc(1, sizeof(*t));
+
+    if (!t)
+        return NULL;
+    t->in = fopen(path, "r");
+    t->out = out_path ? fopen(out_path, "w") : stdout;
+    if (!t->in || !t->out) {
+        perror(t->in ? out_path : path);
+        trace_close(t);
+        return NULL;
+    }
+    trace_read_next(t);
+    return t;
+}
+
+void trace_close(trace_t *t)
+{
+    if (!t)
+        return;
+    if (t->out)
+        fflush(t->out);
+    if (t->out && t->out != stdout)
+        fclose(t->out);
+    if (t->in)
+        fclose(t->in);
+    free(t->line);
+    free(t);
+}
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** trace_run - replaying a trace on the virtual clock
+*/
+
+#include "trace.h"
+#include "clock.h"
+#include "hunger.h"
+#include "net_client.h"
+#include <string.h>
+
+/* The client's player, if it is still connected, and its index */
+static player_t *client_player(const trace_t *t, net_t *net, int client,
+    int *idx)
+{
+    player_t *pl = player_by_id(&net->pool, t->player_of[client]);
+
+    for (int i = net->nlisten; pl && i < net->nfds; ++i)
+        if (net->players[i] == pl) {
+            *idx = i;
+            return pl;
+        }
+    return NULL;
+}
+
+static void apply_connect(trace_t *t, net_t *net, int client)
+{
+    player_t *pl;
+    int idx;
+
+    if (client_player(t, net, client, &idx))
+        return;
+    pl = net_add_client(net, -1);
+    if (!pl)
+        return;
+    t->player_of[client] = pl->id;
+    t->client_of[PLAYER_SLOT(pl->id)] = client;
+}
+
+static void apply_event(trace_t *t, net_t *net, const trace_event_t *ev)
+{
+    char buf[PLAYER_BUF_SZ];
+    int idx;
+
+    if (ev->op == TRACE_CONNECT) {
+        apply_connect(t, net, ev->client);
+        return;
+    }
+    if (!client_player(t, net, ev->client, &idx))
+        return;
+    if (ev->op == TRACE_CLOSE) {
+        drop_fd(net, idx);
+        return;
+    }
+    if (ev->len + 1 > sizeof(buf))
+        return;
+    memcpy(buf, ev->text, ev->len);
+    buf[ev->len] = '\n';
+    net_client_input(net, idx, buf, (ssize_t)ev->len + 1);
+}
+
+void trace_apply_due(trace_t *t, net_t *net, uint64_t now)
+{
+    while (t->pending && t->next.at <= now) {
+        apply_event(t, net, &t->next);
+        trace_read_next(t);
+    }
+}
+
+void trace_capture(trace_t *t, player_t *p)
+{
+    const char *s = p->out.data + p->out.off;
+    const char *end = p->out.data + p->out.len;
+    unsigned long long now = clock_now_ms();
+    int client = t->client_of[PLAYER_SLOT(p->id)];
+    const char *nl;
+
+    while (s < end) {
+        nl = memchr(s, '\n', (size_t)(end - s));
+        nl = nl ? nl + 1 : end;
+        fprintf(t->out, "%llu %d ", now, client);
+        fwrite(s, 1, (size_t)(nl - s), t->out);
+        if (nl[-1] != '\n')
+            fputc('\n', t->out);
+        s = nl;
+    }
+    p->out.off = 0;
+    p->out.len = 0;
+    if (ferror(t->out))
+        t->failed = true;
+}
+
+/* The earliest of the next event, the next action and the next meal */
+static uint64_t next_due(const trace_t *t, const net_t *net)
+{
+    uint64_t due = t->next.at;
+    uint64_t meal = hunger_next_due(net);
+
+    if (net->sched->len && net->sched->items[0].exec_at < due)
+        due = net->sched->items[0].exec_at;
+    return meal < due ? meal : due;
+}
+
+bool trace_run(trace_t *t, net_t *net, const volatile sig_atomic_t *stop)
+{
+    uint64_t now;
+
+    while (!*stop && t->pending && !t->failed) {
+        clock_advance(next_due(t, net));
+        now = clock_now_ms();
+        trace_apply_due(t, net, now);
+        hunger_check(net, now);
+        scheduler_run_ready(net->sched, now);
+        net_flush_all(net);
+        arena_reset(&net->tick);
+        net_drop_doomed(net);
+    }
+    if (fflush(t->out) != 0)
+        t->failed = true;
+    return !t->failed;
+}
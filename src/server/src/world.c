@@ -6,48 +6,79 @@
 */
 
 #include "world.h"
+#include "journal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 static const double DENS[RES_MAX] = {0.5, 0.3, 0.15, 0.1, 0.1, 0.08, 0.05};
 
-static void place_once(world_t *w, res_t id)
+static void scatter_batch(world_t *w, rng_stream_t stream, res_t id, size_t n)
 {
-    int idx = rand() % (w->w * w->h);
+    uint32_t xs[WORLD_SCATTER_BATCH];
+    uint32_t ys[WORLD_SCATTER_BATCH];
+    tile_t *t;
 
-    w->tiles[idx].res[id]++;
+    rng_fill_below(&w->rng[stream], (uint32_t)w->w, xs, n);
+    rng_fill_below(&w->rng[stream], (uint32_t)w->h, ys, n);
+    for (size_t i = 0; i < n; ++i) {
+        t = world_get_tile(w, (int)xs[i], (int)ys[i]);
+        if (t && tile_res_add(w, t, id, 1))
+            journal_event(w->journal, J_DROP,
+                (uint64_t[]){xs[i], ys[i], (uint64_t)id}, 3);
+    }
+}
+
+/* x and y are drawn apart so the area never has to fit in 32 bits */
+void world_scatter(world_t *w, rng_stream_t stream, res_t id, uint64_t count)
+{
+    size_t n;
+
+    while (count > 0) {
+        n = count < WORLD_SCATTER_BATCH ? (size_t)count : WORLD_SCATTER_BATCH;
+        scatter_batch(w, stream, id, n);
+        count -= n;
+    }
 }
 
 static void spawn_resources(world_t *w)
 {
-    int area = w->w * w->h;
-    int n = 0;
+    double area = (double)w->w * (double)w->h;
+    uint64_t n = 0;
 
     for (res_t id = 0; id < RES_MAX; ++id) {
-        n = (int)(area * DENS[id] + 0.5);
+        n = (uint64_t)(area * DENS[id] + 0.5);
         if (n < 1)
             n = 1;
-        for (int i = 0; i < n; ++i)
-            place_once(w, id);
+        world_scatter(w, RNG_WORLD, id, n);
     }
 }
 
+static void seed_streams(world_t *w, const cfg_t *cfg)
+{
+    uint64_t seed = cfg->seeded ? cfg->seed : (uint64_t)time(NULL);
+
+    w->seed = seed;
+    for (int s = 0; s < RNG_STREAMS; ++s)
+        rng_seed(&w->rng[s], seed, (rng_stream_t)s);
+}
+
 bool world_create(world_t *w, const cfg_t *cfg)
 {
     memset(w, 0, sizeof(*w));
     w->w = cfg->width;
     w->h = cfg->height;
-    w->tiles = calloc((size_t)w->w * w->h, sizeof(tile_t));
-    if (!w->tiles)
+    if (!world_chunks_init(w)) {
+        world_destroy(w);
         return false;
-    srand((unsigned)time(NULL));
+    }
+    seed_streams(w, cfg);
     spawn_resources(w);
     return true;
 }
 
 void world_destroy(world_t *w)
 {
-    free(w->tiles);
+    world_chunks_free(w);
     memset(w, 0, sizeof(*w));
 }
@@ -0,0 +1,73 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** world_chunk - lazily allocated tile chunks
+*/
+
+#include "world.h"
+#include <stdlib.h>
+
+static const tile_t EMPTY_TILE = {.egg_head = -1};
+
+bool world_chunks_init(world_t *w)
+{
+    w->cols = ((size_t)w->w + WORLD_CHUNK - 1) >> WORLD_CHUNK_SHIFT;
+    w->rows = ((size_t)w->h + WORLD_CHUNK - 1) >> WORLD_CHUNK_SHIFT;
+    w->chunks = calloc(w->cols * w->rows, sizeof(chunk_t *));
+    return w->chunks != NULL;
+}
+
+static void chunk_free(chunk_t *c)
+{
+    if (!c)
+        return;
+    for (size_t t = 0; c->frags && t < WORLD_CHUNK_TILES; ++t)
+        outbuf_free(&c->frags[t].text);
+    free(c->frags);
+    free(c);
+}
+
+void world_chunks_free(world_t *w)
+{
+    for (size_t i = 0; w->chunks && i < w->cols * w->rows; ++i)
+        chunk_free(w->chunks[i]);
+    free(w->chunks);
+    w->chunks = NULL;
+}
+
+static chunk_t *chunk_alloc(world_t *w, size_t at)
+{
+    chunk_t *c = calloc(1, sizeof(*c));
+
+    if (!c)
+        return NULL;
+    for (size_t i = 0; i < WORLD_CHUNK_TILES; ++i)
+        c->tiles[i].egg_head = -1;
+    w->chunks[at] = c;
+    return c;
+}
+
+tile_t *world_get_tile(world_t *w, int x, int y)
+{
+    size_t at;
+    chunk_t *c;
+
+    if (!w || !w->chunks || w->w <= 0 || w->h <= 0)
+        return NULL;
+    x = (x % w->w + w->w) % w->w;
+    y = (y % w->h + w->h) % w->h;
+    at = (size_t)(y >> WORLD_CHUNK_SHIFT) * w->cols
+        + (size_t)(x >> WORLD_CHUNK_SHIFT);
+    c = w->chunks[at];
+    if (!c)
+        c = chunk_alloc(w, at);
+    return c ? &c->tiles[world_chunk_slot(x, y)] : NULL;
+}
+
+const tile_t *world_peek_tile(const world_t *w, int x, int y)
+{
+    const chunk_t *c = world_chunk(w, x, y);
+
+    return c ? &c->tiles[world_chunk_slot(x, y)] : &EMPTY_TILE;
+}
@@ -6,60 +6,40 @@
 */
 
 #include "world.h"
-#include <stdlib.h>
 
 static const double DENS[RES_MAX] = {0.5, 0.3, 0.15, 0.1, 0.1, 0.08, 0.05};
 
-static void place_once(world_t *w, res_t id)
-{
-    int idx = rand() % (w->w * w->h);
-
-    w->tiles[idx].res[id]++;
-}
-
-static int count_res(const world_t *w, res_t id)
-{
-    int total = 0;
-
-    for (int i = 0; i < w->w * w->h; ++i)
-        total += w->tiles[i].res[id];
-    return total;
-}
-
 static void ensure_minimum_resources(world_t *w)
 {
     for (res_t id = 0; id < RES_MAX; ++id) {
-        if (count_res(w, id) == 0) {
-            place_once(w, id);
+        if (w->totals[id] == 0) {
+            world_scatter(w, RNG_REFILL, id, 1);
         }
     }
 }
 
 static void spawn_resources_by_density(world_t *w, double density_factor)
 {
-    int area = w->w * w->h;
-    int target = 0;
-    int have = 0;
-    int need = 0;
+    double area = (double)w->w * (double)w->h;
+    int64_t target = 0;
+    int64_t need = 0;
 
     if (area <= 0)
         return;
     for (res_t id = 0; id < RES_MAX; ++id) {
-        target = (int)(area * DENS[id] * density_factor + 0.5);
+        target = (int64_t)(area * DENS[id] * density_factor + 0.5);
         if (target < 1)
             target = 1;
-        have = count_res(w, id);
-        need = target - have;
+        need = target - (int64_t)w->totals[id];
         spawn_resources_if_needed(w, id, need);
     }
 }
 
-void spawn_resources_if_needed(world_t *w, res_t id, int need)
+void spawn_resources_if_needed(world_t *w, res_t id, int64_t need)
 {
     if (need <= 0)
         return;
-    for (int i = 0; i < need; ++i)
-        place_once(w, id);
+    world_scatter(w, RNG_REFILL, id, (uint64_t)need);
 }
 
 void world_respawn(world_t *w)
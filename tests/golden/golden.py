@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""Golden-trace regression harness for zappy_server.
+
+A trace is a recorded client input stream, replayed by the server with -t on
+its virtual clock: the run is deterministic and as fast as the CPU allows.
+The harness times the replay and checks that every byte the clients received
+matches the stored golden output.
+
+    golden.py run [case ...]        replay, measure and compare
+    golden.py run --update [case]   replay and store the output as golden
+    golden.py generate out.trace    write a synthetic trace
+
+Each case is a <name>.trace file in this directory. Its "# args:" comment
+holds the server options, and its golden output is <name>.out.gz.
+"""
+
+import argparse
+import gzip
+import hashlib
+import json
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SERVER = os.path.join(HERE, "..", "..", "zappy_server")
+
+# name, cost in ticks, weight; arguments are filled in by bot_line
+COMMANDS = [
+    ("Forward", 7, 30), ("Right", 7, 10), ("Left", 7, 10), ("Look", 7, 15),
+    ("Inventory", 1, 8), ("Broadcast", 7, 8), ("Connect_nbr", 0, 3),
+    ("Take", 7, 10), ("Set", 7, 3), ("Fork", 42, 1), ("Eject", 7, 1),
+    ("Incantation", 300, 1),
+]
+RESOURCES = ["food", "linemate", "deraumere", "sibur", "mendiane", "phiras",
+             "thystame"]
+
+
+def trace_args(path):
+    with open(path) as f:
+        for line in f:
+            match = re.match(r"#\s*args:\s*(.*)", line)
+            if match:
+                return match.group(1).split()
+            if not line.startswith("#"):
+                break
+    raise SystemExit(f"{path}: missing '# args:' line")
+
+
+def count_syscalls(cmd):
+    """Runs cmd under strace and returns its total syscall count."""
+    if not shutil.which("strace"):
+        return None
+    with tempfile.NamedTemporaryFile(suffix=".strace") as log:
+        subprocess.run(["strace", "-f", "-c", "-q", "-o", log.name, *cmd],
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        for line in open(log.name):
+            fields = line.split()
+            if fields and fields[-1] == "total":
+                return int(fields[3] if len(fields) >= 5 else fields[2])
+    return None
+
+
+def replay(trace, out_path):
+    """Replays a trace, returns the measures of the run."""
+    cmd = [SERVER, *trace_args(trace), "-t", trace, "-o", out_path]
+    start = time.perf_counter()
+    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL,
+                            stderr=subprocess.PIPE)
+    _, status, usage = os.wait4(proc.pid, 0)
+    wall = time.perf_counter() - start
+    err = proc.stderr.read().decode(errors="replace")
+    proc.stderr.close()
+    code = os.waitstatus_to_exitcode(status)
+    if code != 0:
+        raise SystemExit(f"{trace}: server exited with {code}\n{err}")
+    return cmd, {
+        "wall_s": round(wall, 4),
+        "cpu_user_s": round(usage.ru_utime, 4),
+        "cpu_sys_s": round(usage.ru_stime, 4),
+        "peak_rss_kib": usage.ru_maxrss,
+    }
+
+
+def run_case(name, update, syscalls):
+    trace = os.path.join(HERE, name + ".trace")
+    golden = os.path.join(HERE, name + ".out.gz")
+    with tempfile.TemporaryDirectory() as tmp:
+        out_path = os.path.join(tmp, name + ".out")
+        cmd, report = replay(trace, out_path)
+        if syscalls:
+            report["syscalls"] = count_syscalls(cmd)
+        with open(out_path, "rb") as f:
+            output = f.read()
+    report["case"] = name
+    report["output_bytes"] = len(output)
+    report["output_sha256"] = hashlib.sha256(output).hexdigest()
+    if update:
+        with gzip.GzipFile(golden, "wb", mtime=0) as f:
+            f.write(output)
+        report["golden"] = "updated"
+        return report, True
+    with gzip.open(golden, "rb") as f:
+        expected = f.read()
+    report["golden"] = "match" if output == expected else "MISMATCH"
+    if output != expected:
+        report["first_difference"] = first_difference(output, expected)
+    return report, output == expected
+
+
+def first_difference(output, expected):
+    got = output.split(b"\n")
+    want = expected.split(b"\n")
+    for i, (a, b) in enumerate(zip(got, want)):
+        if a != b:
+            return {"line": i + 1, "got": a.decode(errors="replace"),
+                    "expected": b.decode(errors="replace")}
+    return {"line": min(len(got), len(want)) + 1,
+            "got_lines": len(got), "expected_lines": len(want)}
+
+
+def all_cases():
+    return sorted(f[:-len(".trace")] for f in os.listdir(HERE)
+                  if f.endswith(".trace"))
+
+
+def bot_line(rng, bot):
+    name, cost, _ = rng.choices(COMMANDS, [c[2] for c in COMMANDS])[0]
+    if name == "Take" and rng.random() < 0.5:
+        return "Take food", cost
+    if name in ("Take", "Set"):
+        return f"{name} {rng.choice(RESOURCES)}", cost
+    if name == "Broadcast":
+        return f"{name} bot{bot}-{rng.randrange(1000)}", cost
+    return name, cost
+
+
+def bot_events(rng, bot, team, args):
+    """One bot: joins, keeps about two commands queued, leaves at the end."""
+    tick = 1000 / args.freq
+    at = bot * args.stagger
+    end = args.seconds * 1000
+    events = [(at, bot, "connect"), (at, bot, "send " + team)]
+    while True:
+        line, cost = bot_line(rng, bot)
+        at += max(1, round(rng.uniform(0.5, 1.0) * max(cost, 1) * tick))
+        if at >= end:
+            break
+        events.append((at, bot, "send " + line))
+    events.append((end, bot, "close"))
+    return events
+
+
+def generate(args):
+    rng = random.Random(args.seed)
+    teams = [f"team{i + 1}" for i in range(args.teams)]
+    events = []
+    for bot in range(args.bots):
+        events += bot_events(rng, bot, teams[bot % len(teams)], args)
+    if args.gui:
+        gui = args.bots
+        start = max(0, args.seconds * 1000 - args.gui * 1000)
+        events += [(start, gui, "connect"), (start, gui, "send GRAPHIC"),
+                   (args.seconds * 1000, gui, "close")]
+    events.sort(key=lambda e: (e[0], e[1]))
+    slots = (args.bots + args.teams - 1) // args.teams
+    with open(args.output, "w") as f:
+        f.write(f"# {args.bots} bots for {args.seconds} s of game time, "
+                f"seed {args.seed}\n")
+        f.write(f"# args: -x {args.width} -y {args.height}"
+                f" -n {' '.join(teams)} -c {slots} -f {args.freq}"
+                f" -s {args.seed}\n")
+        for at, client, op in events:
+            f.write(f"{at} {client} {op}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+    run = sub.add_parser("run", help="replay cases and compare to golden")
+    run.add_argument("cases", nargs="*")
+    run.add_argument("--update", action="store_true",
+                     help="store the output as the new golden copy")
+    run.add_argument("--syscalls", action="store_true",
+                     help="also count syscalls with strace")
+    gen = sub.add_parser("generate", help="write a synthetic trace")
+    gen.add_argument("output")
+    gen.add_argument("--bots", type=int, default=200)
+    gen.add_argument("--teams", type=int, default=4)
+    gen.add_argument("--seconds", type=int, default=600)
+    gen.add_argument("--freq", type=int, default=100)
+    gen.add_argument("--width", type=int, default=30)
+    gen.add_argument("--height", type=int, default=30)
+    gen.add_argument("--stagger", type=int, default=5,
+                     help="milliseconds between two bots joining")
+    gen.add_argument("--gui", type=int, default=0,
+                     help="seconds a GUI watches at the end, 0 for none")
+    gen.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+    if args.command == "generate":
+        generate(args)
+        return 0
+    ok = True
+    for name in args.cases or all_cases():
+        report, matched = run_case(name, args.update, args.syscalls)
+        print(json.dumps(report))
+        ok = ok and matched
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
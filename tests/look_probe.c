@@ -0,0 +1,92 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** look_probe - checks LOOK_TABLE against the former Look traversal
+*/
+
+#include "look_table.h"
+#include <stdio.h>
+
+typedef struct s_pos {
+    int x;
+    int y;
+} pos_t;
+
+/* The traversal LOOK_TABLE replaced: one switch and two modulos a tile */
+static int old_wrap(int v, int max)
+{
+    v %= max;
+    if (v < 0)
+        v += max;
+    return v;
+}
+
+static pos_t old_coord(int dir, int x, int y, pos_t d)
+{
+    pos_t p[4] = {
+        {x + d.y, y - d.x}, {x + d.x, y + d.y},
+        {x - d.y, y + d.x}, {x - d.x, y - d.y},
+    };
+
+    return p[dir];
+}
+
+/* The new one, as traverse_view picks between look_far and look_near */
+static pos_t new_coord(int dir, int i, pos_t at, pos_t map)
+{
+    const look_off_t *o = &LOOK_TABLE[dir][i];
+    pos_t p = {at.x + o->dx, at.y + o->dy};
+
+    if (map.x >= LOOK_MAX_LEVEL && map.y >= LOOK_MAX_LEVEL)
+        return (pos_t){look_wrap_near(p.x, map.x),
+            look_wrap_near(p.y, map.y)};
+    return (pos_t){old_wrap(p.x, map.x), old_wrap(p.y, map.y)};
+}
+
+/* Tile i of a level-8 cone, in Look order: distance, then offset */
+static int check_tile(int dir, int i, pos_t at, pos_t map)
+{
+    int dist = 0;
+    pos_t want;
+    pos_t got = new_coord(dir, i, at, map);
+
+    while (LOOK_TILES(dist) <= i)
+        ++dist;
+    want = old_coord(dir, at.x, at.y,
+        (pos_t){dist, i - LOOK_TILES(dist - 1) - dist});
+    want = (pos_t){old_wrap(want.x, map.x), old_wrap(want.y, map.y)};
+    if (want.x == got.x && want.y == got.y)
+        return 0;
+    printf("mismatch dir %d tile %d at %d %d on %dx%d: %d %d, not %d %d\n",
+        dir, i, at.x, at.y, map.x, map.y, got.x, got.y, want.x, want.y);
+    return 1;
+}
+
+static int check_map(pos_t map, long *count)
+{
+    for (int dir = 0; dir < 4; ++dir)
+        for (int y = 0; y < map.y; ++y)
+            for (int x = 0; x < map.x; ++x)
+                for (int i = 0; i < LOOK_TILES(LOOK_MAX_LEVEL); ++i) {
+                    if (check_tile(dir, i, (pos_t){x, y}, map))
+                        return 1;
+                    ++*count;
+                }
+    return 0;
+}
+
+/* Every orientation, position and tile of the cone, on maps 1x1 to 20x20;
+   a level l player reads the first LOOK_TILES(l) tiles, so the level-8
+   cone covers every level */
+int main(void)
+{
+    long count = 0;
+
+    for (int h = 1; h <= 20; ++h)
+        for (int w = 1; w <= 20; ++w)
+            if (check_map((pos_t){w, h}, &count))
+                return 1;
+    printf("ok %ld\n", count);
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+** EPITECH PROJECT, 2025
+** B-YEP-400-MPL-4-1-zappy-louis.filhol-valantin
+** File description:
+** replay_probe - drives the GUI's journal reader from the tests
+*/
+
+#include "ReplayReader.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Plays ms of match time from the current position, in 100 ms reads
+static void play(ReplayReader &reader, uint64_t ms, std::string &out) {
+    out.clear();
+    for (uint64_t now = 1; now <= ms + 1; now += 100)
+        reader.read(out, now, 1 << 20);
+}
+
+// replay_probe journal [ms | +ms ...]: prints the keyframe count and
+// duration, then for each ms where a seek lands and the snapshot it hands
+// over, and for each +ms the lines played from there
+int main(int argc, char *argv[]) {
+    ReplayReader reader;
+    std::string out;
+
+    if (argc < 2 || !reader.open(argv[1])) {
+        std::cout << "rejected" << std::endl;
+        return 1;
+    }
+    std::cout << "keyframes " << reader.getKeyframeCount() << " duration "
+        << reader.getDuration() << "\n";
+    for (int i = 2; i < argc; ++i) {
+        if (argv[i][0] == '+') {
+            play(reader, std::strtoull(argv[i] + 1, nullptr, 10), out);
+            std::cout << "play " << argv[i] + 1;
+        } else {
+            reader.seek(std::strtoull(argv[i], nullptr, 10));
+            reader.read(out, 0, 1 << 20);
+            std::cout << "seek " << argv[i];
+        }
+        std::cout << " position " << reader.getPosition() << "\n" << out
+            << "end\n";
+    }
+    return 0;
+}
@@ -1,10 +1,13 @@
+import os
 import subprocess
 import socket
+import tempfile
 import time
+import urllib.request
 
-def start_server():
+def start_server(*extra):
     server = subprocess.Popen(
-        ["../../zappy_server", "-p", "4242", "-x", "10", "-y", "10", "-n", "team1", "team2", "-c", "3", "-f", "10"],
+        ["../../zappy_server", "-p", "4242", "-x", "10", "-y", "10", "-n", "team1", "team2", "-c", "3", "-f", "10", *extra],
         cwd="src/server",
         stdout=subprocess.PIPE,
         stderr=subprocess.PIPE
@@ -31,6 +34,14 @@ class ZappyClient:
             raise AssertionError("Timeout lors de la connexion (pas de réponse du serveur)")
         return response
 
+    def join(self, team_name="team1"):
+        self.s.settimeout(2)
+        self.s.sendall((team_name + "\n").encode())
+        response = ""
+        while response.count("\n") < 2:
+            response += self.recive()
+        return response
+
     def send(self, msg, timeout=2):
         self.s.settimeout(timeout)
         self.s.sendall((msg + "\n").encode())
@@ -193,6 +204,45 @@ def test_broadcast_from_other_team():
     finally:
         stop_server(server)
 
+def test_broadcasts_in_same_tick_all_delivered():
+    server = start_server("-c", "8")
+    try:
+        emitters = [ZappyClient() for _ in range(5)]
+        for client in emitters:
+            client.join("team2")
+        receiver = ZappyClient()
+        receiver.join("team1")
+        for i, client in enumerate(emitters):
+            client.s.sendall(f"Broadcast hello{i}\n".encode())
+        response = ""
+        while response.count("\n") < 5:
+            response += receiver.recive()
+        lines = response.splitlines()
+        assert sorted(line.split(", ", 1)[1] for line in lines) == [f"hello{i}" for i in range(5)]
+        for client in emitters + [receiver]:
+            client.close()
+    finally:
+        stop_server(server)
+
+def test_broadcast_long_message():
+    server = start_server()
+    try:
+        client = ZappyClient()
+        client.connect("team2")
+        client2 = ZappyClient()
+        client2.connect("team1")
+        text = "x" * 600
+        client.s.sendall(("Broadcast " + text + "\n").encode())
+        response = ""
+        while not response.endswith("\n"):
+            response += client2.recive()
+        assert response[:8] == "message " and response[8] in "012345678"
+        assert response[9:] == ", " + text + "\n"
+        client2.close()
+        client.close()
+    finally:
+        stop_server(server)
+
 def test_Connect_nbr():
     server = start_server()
     try:
@@ -322,6 +372,29 @@ def test_look():
     finally:
         stop_server(server)
 
+def test_look_on_map_smaller_than_view():
+    server = start_server("-x", "2", "-y", "2")
+    try:
+        client = ZappyClient()
+        client.connect("team1")
+        response = client.send("Look")
+        assert response.startswith("[player") and response.count(",") == 3
+        client.close()
+    finally:
+        stop_server(server)
+
+def test_look_table_matches_former_traversal():
+    with tempfile.TemporaryDirectory() as tmp:
+        probe = os.path.join(tmp, "look_probe")
+        subprocess.run(["gcc", "-std=c17", "-Wall", "-Wextra", "-Werror",
+                        "-Isrc/server/include", "src/server/src/look_table.c",
+                        "tests/look_probe.c", "-o", probe],
+                       check=True, timeout=60)
+        result = subprocess.run([probe], capture_output=True, text=True,
+                                timeout=60)
+    # 4 orientations, 81 tiles, every position of every map up to 20x20
+    assert (result.returncode, result.stdout) == (0, "ok 14288400\n")
+
 def test_complete_incantation():
     server = start_server()
     try:
@@ -354,6 +427,706 @@ def test_look_after_incantation():
     finally:
         stop_server(server)
 
+def test_gui_snapshot_after_stalled_gui():
+    server = start_server()
+    try:
+        stalled = ZappyClient()
+        stalled.s.sendall(b"GRAPHIC\n")
+        gui = ZappyClient()
+        gui.s.sendall(b"GRAPHIC\n")
+        time.sleep(0.5)
+        response = gui.recive(65536)
+        assert response.startswith("msz 10 10")
+        assert "tna team1" in response and "sgt 10" in response
+        stalled.close()
+        gui.close()
+    finally:
+        stop_server(server)
+
+def read_gui_until_resync(sock, deadline):
+    """Reads a GUI stream until EOF or past a second complete snapshot."""
+    sock.settimeout(1)
+    data = b""
+    while time.time() < deadline:
+        try:
+            chunk = sock.recv(1 << 16)
+        except socket.timeout:
+            continue
+        except ConnectionResetError:
+            return data, True
+        if not chunk:
+            return data, True
+        data += chunk
+        resync = data.find(b"\nmsz ")
+        if resync >= 0 and b"\nsgt " in data[resync:]:
+            return data, False
+    raise AssertionError("Timeout: no resync snapshot and no disconnect")
+
+def test_stalled_gui_resynced_or_dropped():
+    server = start_server("-f", "200", "-c", "20", "-a", "4252")
+    try:
+        stalled = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        stalled.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+        stalled.connect(("localhost", 4242))
+        stalled.recv(8)
+        stalled.sendall(b"GRAPHIC\n")
+        bots = [ZappyClient() for _ in range(40)]
+        for i, bot in enumerate(bots):
+            bot.join("team%d" % (i % 2 + 1))
+            bot.s.setblocking(False)
+        line = b"Broadcast " + b"x" * 700 + b"\n"
+        resyncs = "zappy_gui_resyncs_total 0"
+        deadline = time.time() + 10
+        while resyncs.endswith(" 0") and time.time() < deadline:
+            for bot in bots:
+                bot.s.sendall(line * 2)
+                try:
+                    while bot.s.recv(1 << 20):
+                        pass
+                except BlockingIOError:
+                    pass
+            time.sleep(0.03)
+            resyncs = [l for l in read_metrics(4252).splitlines()
+                       if l.startswith("zappy_gui_resyncs_total")][0]
+        for bot in bots:
+            bot.close()
+        assert not resyncs.endswith(" 0")
+        data, closed = read_gui_until_resync(stalled, time.time() + 10)
+        lines = data.decode().split("\n")[:-1]
+        assert lines[0].startswith("msz 10 10")
+        # Queued deltas are dropped on whole lines, never mid-message
+        assert all(l.split(" ")[0] in ("msz", "bct", "tna", "pnw", "sgt",
+                   "pbc", "pdi", "pin", "ppo") for l in lines)
+        if not closed:
+            resync = max(i for i, l in enumerate(lines) if l.startswith("msz"))
+            assert resync > 0
+            assert lines[resync + 101].startswith("tna team1")
+            assert any(l.startswith("sgt 200") for l in lines[resync:])
+        stalled.close()
+    finally:
+        stop_server(server)
+
+def test_unix_socket_join():
+    path = "/tmp/zappy_test.sock"
+    server = start_server("-u", path)
+    try:
+        s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        s.settimeout(2)
+        s.connect(path)
+        assert s.recv(1024).decode() == "WELCOME\n"
+        s.sendall(b"team1\n")
+        time.sleep(0.2)
+        assert "10 10" in s.recv(1024).decode()
+        s.close()
+    finally:
+        stop_server(server)
+
+def test_shm_feed_keyframe():
+    import mmap
+    import struct
+    server = start_server("-m", "zappy_test_feed")
+    try:
+        with open("/dev/shm/zappy_test_feed", "rb") as f:
+            m = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, _, cap, kf_cap, _, _, seq = struct.unpack_from("<IIQQQQQ", m, 0)
+        assert magic == 0x5a52494e and seq >= 1
+        slot = seq & 1
+        kf_len = struct.unpack_from("<Q", m, 72 + 8 * slot)[0]
+        start = 128 + cap + slot * kf_cap
+        frame = m[start:start + kf_len].decode()
+        assert frame.startswith("msz 10 10\n")
+        assert "tna team1\n" in frame and frame.endswith("sgt 10\n")
+        m.close()
+    finally:
+        stop_server(server)
+
+def read_until(client, text, timeout=5):
+    client.s.settimeout(timeout)
+    data = ""
+    deadline = time.time() + timeout
+    while text not in data and time.time() < deadline:
+        chunk = client.s.recv(65536).decode()
+        if not chunk:
+            break
+        data += chunk
+    return data
+
+def test_relay_fans_out_to_spectators():
+    server = start_server()
+    relay = subprocess.Popen(
+        ["./zappy_relay", "-p", "4343", "-h", "127.0.0.1", "-u", "4242",
+         "-t", "2"],
+        stdout=subprocess.PIPE, stderr=subprocess.PIPE
+    )
+    try:
+        time.sleep(0.5)
+        viewers = [ZappyClient(port=4343) for _ in range(2)]
+        for viewer in viewers:
+            assert viewer.welcome == "WELCOME\n"
+            viewer.s.sendall(b"GRAPHIC\n")
+            snapshot = read_until(viewer, "sgt 10\n")
+            assert snapshot.startswith("msz 10 10\n")
+            assert "tna team1" in snapshot and "sgt 10\n" in snapshot
+        client = ZappyClient()
+        client.join("team1")
+        for viewer in viewers:
+            assert "pnw #" in read_until(viewer, "pnw #")
+        client.close()
+        for viewer in viewers:
+            viewer.close()
+        # Losing the upstream ends the relay instead of leaving it spinning
+        stop_server(server)
+        assert relay.wait(timeout=5) == 0
+    finally:
+        if relay.poll() is None:
+            relay.terminate()
+            relay.wait(timeout=10)
+        if server.poll() is None:
+            stop_server(server)
+
+def test_loadgen_reports_joins_and_latency():
+    subprocess.run(["make", "-s", "zappy_loadgen"], check=True,
+                   stdout=subprocess.DEVNULL)
+    server = start_server("-c", "10", "-f", "100")
+    try:
+        run = subprocess.run(
+            ["./zappy_loadgen", "-p", "4242", "-n", "team1", "team2",
+             "-c", "20", "-d", "2", "-f", "100"],
+            capture_output=True, text=True, timeout=15
+        )
+        assert run.returncode == 0, run.stderr
+        lines = run.stdout.splitlines()
+        counts = next(l for l in lines if l.startswith("# connects"))
+        assert int(counts.split("joins ")[1].split(",")[0]) > 0
+        header = next(l for l in lines if l.startswith("command"))
+        assert "lat_p50" in header and "lat_p99" in header
+        rows = [l.split() for l in lines[lines.index(header) + 1:]]
+        assert rows[-1][0] == "total" and int(rows[-1][1]) > 0
+        # A command with replies has measured, not empty, percentiles
+        assert any(int(r[1]) > 0 and float(r[3]) > 0 for r in rows[:-1])
+    finally:
+        stop_server(server)
+
+def test_relay_keeps_forwarded_lines_whole():
+    # A fake upstream that stops reading makes the relay's sends fall short
+    upstream = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    upstream.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    upstream.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+    upstream.bind(("127.0.0.1", 4344))
+    upstream.listen(1)
+    relay = subprocess.Popen(
+        ["./zappy_relay", "-p", "4345", "-h", "127.0.0.1", "-u", "4344"],
+        stdout=subprocess.PIPE, stderr=subprocess.PIPE
+    )
+    try:
+        upstream.settimeout(5)
+        conn, _ = upstream.accept()
+        conn.sendall(b"WELCOME\nmsz 1 1\nbct 0 0 0 0 0 0 0 0 0\nsgt 10\n")
+        time.sleep(0.5)
+        viewer = ZappyClient(port=4345)
+        viewer.s.sendall(b"GRAPHIC\n")
+        assert "sgt 10\n" in read_until(viewer, "sgt 10\n")
+        wanted = ["GRAPHIC"] + ["sst %d" % i for i in range(1, 300001)]
+        viewer.s.sendall("".join(l + "\n" for l in wanted[1:]).encode())
+        time.sleep(1)
+        conn.settimeout(5)
+        data = b""
+        while not data.endswith(b"sst 300000\n"):
+            chunk = conn.recv(1 << 16)
+            assert chunk, "relay closed the upstream"
+            data += chunk
+        assert data.decode().splitlines() == wanted
+        viewer.close()
+        conn.close()
+        assert relay.wait(timeout=5) == 0
+    finally:
+        if relay.poll() is None:
+            relay.terminate()
+            relay.wait(timeout=10)
+        upstream.close()
+
+def test_connect_storm_reuses_player_slots():
+    server = start_server()
+    try:
+        for _ in range(3):
+            clients = [ZappyClient() for _ in range(100)]
+            assert all("WELCOME" in c.welcome for c in clients)
+            for c in clients:
+                c.close()
+            time.sleep(0.2)
+        client = ZappyClient()
+        assert "2\n10 10" in client.connect("team1")
+        client.close()
+    finally:
+        stop_server(server)
+
+def test_reuseport_acceptors():
+    server = start_server("-r", "4")
+    try:
+        clients = [ZappyClient() for _ in range(50)]
+        assert all("WELCOME" in c.welcome for c in clients)
+        assert "2\n10 10" in clients[0].connect("team1")
+        for c in clients:
+            c.close()
+    finally:
+        stop_server(server)
+
+def test_full_server_refuses_without_welcome():
+    server = start_server("-r", "2")
+    try:
+        clients = [ZappyClient() for _ in range(130)]
+        welcomed = [c for c in clients if c.welcome == "WELCOME\n"]
+        # One poll slot holds the acceptors' hand-off pipe
+        assert len(welcomed) == 127
+        assert all(c.welcome == "" for c in clients if c not in welcomed)
+        for c in clients:
+            c.close()
+    finally:
+        stop_server(server)
+
+def test_look_lists_every_player_on_crowded_tile():
+    server = start_server("-x", "1", "-y", "1", "-c", "120")
+    try:
+        clients = [ZappyClient() for _ in range(110)]
+        for client in clients:
+            client.join("team1")
+        clients[0].s.sendall(b"Look\n")
+        response = ""
+        while not response.endswith("]\n"):
+            response += clients[0].recive(65536)
+        assert response.count(",") == 3
+        assert response.count("player") == 4 * 110
+        for client in clients:
+            client.close()
+    finally:
+        stop_server(server)
+
+def test_look_sees_tile_change():
+    server = start_server()
+    try:
+        client = ZappyClient()
+        client.connect("team1")
+        before = client.send("Look").strip("[]\n").split(",")[0].split()
+        assert "ok" in client.send("Set food")
+        after = client.send("Look").strip("[]\n").split(",")[0].split()
+        assert after.count("food") == before.count("food") + 1
+        assert after.count("player") == 1
+        client.close()
+    finally:
+        stop_server(server)
+
+def test_player_ids_not_reused_after_disconnect():
+    server = start_server()
+    try:
+        gui = ZappyClient()
+        gui.s.sendall(b"GRAPHIC\n")
+        ids = []
+        for _ in range(2):
+            client = ZappyClient()
+            client.join("team1")
+            feed = ""
+            while "pnw #" not in feed or not feed.endswith("\n"):
+                feed += gui.recive(65536)
+            ids.append(feed.split("pnw #", 1)[1].split()[0])
+            client.close()
+            time.sleep(0.2)
+        assert ids[0] != ids[1]
+        gui.close()
+    finally:
+        stop_server(server)
+
+def test_fork_then_eject_destroys_eggs():
+    server = start_server("-f", "100")
+    try:
+        gui = ZappyClient()
+        gui.s.sendall(b"GRAPHIC\n")
+        client = ZappyClient()
+        client.join("team1")
+        assert "ok" in client.send("Fork")
+        assert "ok" in client.send("Fork")
+        assert client.send("Connect_nbr").strip() == "4"
+        client.send("Eject")
+        feed = ""
+        while feed.count("ebo #") < 2:
+            feed += gui.recive(65536)
+        assert feed.count("enw #") == 2
+        client.close()
+        gui.close()
+    finally:
+        stop_server(server)
+
+def test_join_among_many_teams():
+    names = [f"t{i}" for i in range(40)]
+    server = start_server("-n", *names)
+    try:
+        for name in ("t0", "t39", "t17"):
+            client = ZappyClient()
+            assert client.join(name).splitlines()[1] == "10 10"
+            client.close()
+        client = ZappyClient()
+        assert "ko" in client.send("t40")
+        client.close()
+    finally:
+        stop_server(server)
+
+def read_map_snapshot(tiles=100):
+    gui = ZappyClient()
+    gui.s.sendall(b"GRAPHIC\n")
+    feed = ""
+    while feed.count("bct ") < tiles or not feed.endswith("\n"):
+        feed += gui.recive(65536)
+    gui.close()
+    return sorted(line for line in feed.splitlines() if line.startswith("bct "))
+
+def test_seed_reproduces_map():
+    maps = []
+    for seed in ("42", "42", "43"):
+        server = start_server("-s", seed)
+        try:
+            maps.append(read_map_snapshot())
+        finally:
+            stop_server(server)
+    assert maps[0] == maps[1]
+    assert maps[0] != maps[2]
+
+def test_map_not_aligned_on_chunks():
+    server = start_server("-x", "37", "-y", "21", "-f", "100")
+    try:
+        lines = read_map_snapshot(37 * 21)
+        coords = {tuple(map(int, line.split()[1:3])) for line in lines}
+        food = sum(int(line.split()[3]) for line in lines)
+        assert coords == {(x, y) for x in range(37) for y in range(21)}
+        assert food == 389
+        client = ZappyClient()
+        client.join("team1")
+        for _ in range(40):
+            assert client.send("Forward").strip() == "ok"
+        assert client.send("Look").startswith("[player")
+        client.close()
+    finally:
+        stop_server(server)
+
+def read_metrics(port):
+    with urllib.request.urlopen("http://127.0.0.1:%d/metrics" % port, timeout=2) as r:
+        return r.read().decode()
+
+def test_metrics_endpoint():
+    server = start_server("-a", "4250", "-f", "100")
+    try:
+        client = ZappyClient()
+        client.join("team1")
+        assert client.send("Forward").strip() == "ok"
+        assert client.send("Bogus").strip() == "ko"
+        text = read_metrics(4250)
+        assert 'zappy_actions_fired_total{command="Forward"} 1' in text
+        assert "zappy_commands_rejected_total 1" in text
+        assert "zappy_connections 1" in text
+        assert "zappy_loop_seconds_count" in text
+        bytes_in = [l for l in text.splitlines() if l.startswith("zappy_client_bytes_in_total{")]
+        assert len(bytes_in) == 1 and bytes_in[0].endswith(" %d" % len("team1\nForward\nBogus\n"))
+        client.close()
+    finally:
+        stop_server(server)
+
+def test_drift_report_and_clean_shutdown():
+    server = start_server("-a", "4251", "-f", "100")
+    try:
+        client = ZappyClient()
+        client.join("team1")
+        assert client.send("Forward").strip() == "ok"
+        with urllib.request.urlopen("http://127.0.0.1:4251/drift", timeout=2) as r:
+            rows = {l.split()[0]: l.split()[1:] for l in r.read().decode().splitlines() if not l.startswith("#")}
+        assert rows["Forward"][0] == "1"
+        assert int(rows["Forward"][3]) <= int(rows["Forward"][5])
+        client.close()
+    finally:
+        stop_server(server)
+    assert server.returncode == 0
+    assert "Forward" in server.stderr.read().decode()
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, pos
+
+def read_varints(data, pos, n):
+    out = []
+    for _ in range(n):
+        v, pos = read_varint(data, pos)
+        out.append(v)
+    return out, pos
+
+def test_match_journal():
+    fd, path = tempfile.mkstemp(suffix=".zjnl")
+    os.close(fd)
+    server = start_server("-j", path, "-s", "7")
+    try:
+        client = ZappyClient()
+        client.join("team1")
+        assert client.send("Forward").strip() == "ok"
+        assert client.send("Right").strip() == "ok"
+        assert client.send("Set food").strip() == "ok"
+        assert "message 0, hello" in client.send("Broadcast hello")
+        client.close()
+        time.sleep(0.2)
+    finally:
+        stop_server(server)
+    with open(path, "rb") as f:
+        data = f.read()
+    os.unlink(path)
+    assert data[:4] == b"ZJNL"
+    (version, w, h, freq, seed, _, teams), pos = read_varints(data, 4, 7)
+    assert (version, w, h, freq, seed, teams) == (3, 10, 10, 10, 7, 2)
+    for _ in range(teams):
+        n, pos = read_varint(data, pos)
+        pos += n
+    assert data[pos] == 1
+    (_, kf_freq), pos = read_varints(data, pos + 1, 2)
+    assert kf_freq == 10
+    _, pos = read_varints(data, pos, w * h * 7)
+    (players, eggs), pos = read_varints(data, pos, 2)
+    assert (players, eggs) == (0, 0)
+    records = []
+    sizes = {2: 13, 3: 4, 5: 2, 14: 1, 16: 3}
+    while pos < len(data):
+        kind = data[pos]
+        _, pos = read_varint(data, pos + 1)
+        if kind == 15:
+            (pid, n), pos = read_varints(data, pos, 2)
+            records.append((kind, pid, data[pos:pos + n]))
+            pos += n
+            continue
+        assert kind in sizes, kind
+        fields, pos = read_varints(data, pos, sizes[kind])
+        if kind != 16:
+            records.append((kind, *fields))
+    pid = records[0][1]
+    assert records[0][0] == 2
+    assert [r[0] for r in records] == [2, 3, 3, 5, 15, 14]
+    assert records[2][4] == records[1][4] % 4 + 1
+    assert records[3] == (5, pid, 0)
+    assert records[4] == (15, pid, b"hello")
+    assert records[5] == (14, pid)
+
+
+def varint(v):
+    out = b""
+    while v >= 0x80:
+        out += bytes([v & 0x7f | 0x80])
+        v >>= 7
+    return out + bytes([v])
+
+def test_replay_reader_seeks_across_keyframes():
+    # Ten players broadcast 900 bytes every 70 ms: past 1 MiB of records,
+    # the journal gets its second keyframe
+    events = []
+    for bot in range(10):
+        events += [(100, bot, "connect"), (100, bot, "send team%d" % (bot % 2 + 1))]
+        events += [(t, bot, "send Broadcast " + "z" * 900)
+                   for t in range(110, 10000, 70)]
+        events.append((20000, bot, "close"))
+    events.sort()
+    with tempfile.TemporaryDirectory() as tmp:
+        probe = os.path.join(tmp, "replay_probe")
+        subprocess.run(["g++", "-std=c++17", "-Isrc/gui/src/core",
+                        "src/gui/src/core/ReplayReader.cpp",
+                        "tests/replay_probe.cpp", "-o", probe],
+                       check=True, timeout=120)
+        trace = os.path.join(tmp, "t.trace")
+        journal = os.path.join(tmp, "t.zjnl")
+        with open(trace, "w") as f:
+            f.writelines("%d %d %s\n" % e for e in events)
+        subprocess.run(["./zappy_server", "-x", "10", "-y", "10", "-n",
+                        "team1", "team2", "-c", "5", "-f", "100", "-s", "1",
+                        "-t", trace, "-o", os.path.join(tmp, "t.out"),
+                        "-j", journal], capture_output=True, check=True,
+                       timeout=30)
+        result = subprocess.run([probe, journal, "5000", "12000", "99999"],
+                                capture_output=True, text=True, timeout=30)
+        head, rest = result.stdout.split("\n", 1)
+        seeks = rest.split("end\n")[:-1]
+        keyframes, duration = head.split()[1], int(head.split()[3])
+        assert keyframes == "2"
+        # A meal every 1260 ms from 10 food: 7 left at 5 s, 1 at 12 s
+        for seek, at, food in ((seeks[0], 5000, 7), (seeks[1], 12000, 1)):
+            lines = seek.splitlines()
+            assert lines[0] == "seek %d position %d" % (at, at)
+            assert lines[1] == "msz 10 10"
+            pins = [l.split() for l in lines if l.startswith("pin ")]
+            assert len(pins) == 10 and {p[4] for p in pins} == {str(food)}
+        # Every player starved before the end of the journal
+        lines = seeks[2].splitlines()
+        assert lines[0] == "seek 99999 position %d" % duration
+        assert not any(l.startswith("pnw ") for l in lines)
+        with open(journal, "rb") as f:
+            data = f.read()
+        old = os.path.join(tmp, "old.zjnl")
+        with open(old, "wb") as f:
+            f.write(data[:4] + varint(1) + data[5:])
+        huge = os.path.join(tmp, "huge.zjnl")
+        with open(huge, "wb") as f:
+            f.write(data[:5] + varint(60000) + varint(60000) + data[7:])
+        for path in (old, huge):
+            result = subprocess.run([probe, path], capture_output=True,
+                                    text=True, timeout=30)
+            assert (result.returncode, result.stdout) == (1, "rejected\n")
+
+def test_replay_reader_follows_sst():
+    events = ("0 0 connect\n0 0 send GRAPHIC\n0 1 connect\n0 1 send team1\n"
+              "1000 0 send sst 50\n1000 1 send Forward\n"
+              "3000 0 close\n3000 1 close\n")
+    with tempfile.TemporaryDirectory() as tmp:
+        probe = os.path.join(tmp, "replay_probe")
+        subprocess.run(["g++", "-std=c++17", "-Isrc/gui/src/core",
+                        "src/gui/src/core/ReplayReader.cpp",
+                        "tests/replay_probe.cpp", "-o", probe],
+                       check=True, timeout=120)
+        trace = os.path.join(tmp, "t.trace")
+        journal = os.path.join(tmp, "t.zjnl")
+        with open(trace, "w") as f:
+            f.write(events)
+        subprocess.run(["./zappy_server", "-x", "10", "-y", "10", "-n",
+                        "team1", "team2", "-c", "3", "-f", "100", "-s", "1",
+                        "-t", trace, "-o", os.path.join(tmp, "t.out"),
+                        "-j", journal], capture_output=True, check=True,
+                       timeout=30)
+        result = subprocess.run([probe, journal, "500", "+1000", "2000"],
+                                capture_output=True, text=True, timeout=30)
+    before, played, after = result.stdout.split("end\n")[:3]
+    assert "\nsgt 100\n" in before
+    # Playing through the change announces it, then Forward takes 140 ms
+    assert played.splitlines()[1:] == ["sgt 50", "ppo #65537 4 9 2"]
+    assert "\nsgt 50\n" in after
+
+def test_trace_replay_matches_golden():
+    result = subprocess.run(
+        ["python3", "tests/golden/golden.py", "run"],
+        capture_output=True, text=True, timeout=120
+    )
+    assert result.returncode == 0, result.stdout + result.stderr
+    assert '"golden": "match"' in result.stdout
+
+def replay_trace(events, *extra):
+    with tempfile.TemporaryDirectory() as tmp:
+        trace = os.path.join(tmp, "t.trace")
+        out = os.path.join(tmp, "t.out")
+        with open(trace, "w") as f:
+            f.write(events)
+        result = subprocess.run(
+            ["./zappy_server", "-x", "10", "-y", "10", "-n", "team1", "team2",
+             "-c", "3", *extra, "-t", trace, "-o", out],
+            capture_output=True, timeout=30
+        )
+        assert result.returncode == 0
+        with open(out) as f:
+            return f.read().splitlines()
+
+def test_trace_replay():
+    lines = replay_trace("# two players meet\n"
+                         "0 0 connect\n0 0 send team1\n"
+                         "0 1 connect\n0 1 send team2\n"
+                         "5 0 send Broadcast hi\n"
+                         "5 1 send Inventory\n"
+                         "2000 0 close\n2000 1 close\n", "-f", "10")
+    assert lines[:3] == ["0 0 WELCOME", "0 0 2", "0 0 10 10"]
+    assert lines[6].startswith("105 1 [ food 10,")
+    assert lines[7:] == ["705 0 message 0, hi", "705 1 message 6, hi"]
+
+def test_gui_pbc_carries_long_message():
+    text = "y" * 600
+    lines = replay_trace("0 0 connect\n0 0 send team1\n"
+                         "0 1 connect\n0 1 send GRAPHIC\n"
+                         "5 0 send Broadcast " + text + "\n"
+                         "2000 0 close\n2000 1 close\n", "-f", "10")
+    assert "705 1 pbc #65536 " + text in lines
+
+def test_gui_lines_carry_long_team_name():
+    team = "t" * 150
+    lines = replay_trace("0 1 connect\n0 1 send GRAPHIC\n"
+                         "5 0 connect\n5 0 send " + team + "\n"
+                         "10 1 send tna\n20 0 close\n20 1 close\n",
+                         "-n", team, "team2")
+    gui = [l for l in lines if l.split()[1] == "1"]
+    assert [l for l in gui if " tna " in l] == [
+        "0 1 tna " + team, "0 1 tna team2",
+        "10 1 tna " + team, "10 1 tna team2"]
+    pnw = [l for l in gui if " pnw " in l]
+    assert len(pnw) == 1 and pnw[0].endswith(" 8 4 1 1 " + team)
+    assert all(l.split()[2] in ("WELCOME", "msz", "bct", "tna", "pnw",
+                                "pin", "sgt") for l in gui)
+
+def test_incantation_participants_frozen():
+    # With seed 4, the first player spawns on a tile holding a linemate
+    start = "0 0 connect\n0 0 send team1\n5 0 send Incantation\n"
+    lines = replay_trace(start + "10 0 send Incantation\n4000 0 close\n",
+                         "-f", "100", "-s", "4")
+    assert lines[3:] == ["5 0 Elevation underway", "10 0 ko",
+                         "3005 0 Current level: 2"]
+    lines = replay_trace(start + "10 0 send Forward\n4000 0 close\n",
+                         "-f", "100", "-s", "4")
+    assert lines[3:] == ["5 0 Elevation underway", "80 0 ok", "3005 0 ko"]
+
+def test_pic_lists_every_participant():
+    bots = range(40)
+    events = "".join(f"0 {i} connect\n0 {i} send team1\n" for i in bots)
+    events += "0 40 connect\n0 40 send GRAPHIC\n5 0 send Incantation\n"
+    events += "".join(f"20 {i} close\n" for i in range(41))
+    lines = replay_trace(events, "-x", "1", "-y", "1", "-c", "40",
+                         "-f", "100", "-s", "0")
+    pic = [l for l in lines if l.startswith("5 40 pic ")]
+    assert pic == ["5 40 pic 0 0 1 " +
+                   " ".join(f"#{65536 + i}" for i in bots)]
+
+def test_left_client_item_action_not_run_on_reused_slot():
+    lines = replay_trace("0 0 connect\n0 0 send team1\n"
+                         "5 0 send Set food\n6 0 close\n"
+                         "10 1 connect\n10 1 send team2\n"
+                         "1000 1 send Inventory\n2000 1 close\n",
+                         "-f", "10")
+    assert "705 1 ok" not in lines
+    assert any(l.startswith("1100 1 [ food 10,") for l in lines)
+
+def test_left_client_broadcast_not_sent_from_reused_slot():
+    lines = replay_trace("0 0 connect\n0 0 send team1\n"
+                         "5 0 send Broadcast ghost\n6 0 close\n"
+                         "10 1 connect\n10 1 send team2\n"
+                         "10 2 connect\n10 2 send team1\n"
+                         "2000 1 close\n2000 2 close\n", "-f", "10")
+    assert not any("ghost" in l for l in lines)
+
+def test_sst_rescales_pending_actions():
+    lines = replay_trace("0 0 connect\n0 0 send team1\n"
+                         "0 1 connect\n0 1 send GRAPHIC\n"
+                         "5 0 send Forward\n"
+                         "100 1 send sst 100\n100 1 send sgt\n"
+                         "100 1 send sst 0\n100 1 send foo\n"
+                         "2000 0 close\n2000 1 close\n",
+                         "-f", "10", "-s", "1")
+    replies = [l for l in lines if l.startswith("100 1 ")]
+    assert replies == ["100 1 sst 100", "100 1 sgt 100", "100 1 sbp",
+                       "100 1 suc"]
+    # Forward was due at 705 ms: 605 ms left at f=10 become 60 ms at f=100
+    assert "160 0 ok" in lines
+    # The first meal, due at 12600 ms, comes 1250 ms after the change
+    assert any(l.startswith("1350 1 pin ") for l in lines)
+
+def test_sst_refuses_a_refill_period_of_zero():
+    lines = replay_trace("0 1 connect\n0 1 send GRAPHIC\n"
+                         "10 1 send sst 30000\n10 1 send sst 20000\n"
+                         "20 1 close\n", "-f", "10")
+    assert [l for l in lines if l.startswith("10 1 s")] == [
+        "10 1 sbp", "10 1 sst 20000"]
+    # One full map refill per ms at most, not one per loop iteration
+    assert len([l for l in lines if l.startswith("15 1 bct 0 0 ")]) <= 1
+    lines = replay_trace("0 1 connect\n0 1 send GRAPHIC\n20 1 close\n",
+                         "-f", "30000")
+    assert len([l for l in lines if l.startswith("15 1 bct 0 0 ")]) <= 1
+
 if __name__ == "__main__":
     # test_server_accepts_connection()
     # test_server_join_command()